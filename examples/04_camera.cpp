@@ -32,6 +32,13 @@ private:
     glm::mat4 projection{};
 };
 
+// per frame data shared by all the shaders, its members follow the std140 layout of the "Frame" block
+struct FrameUniforms {
+    glm::mat4 camera;
+    glm::vec3 camera_position;
+    float time;
+};
+
 int main() {
     // create a window
     auto options = sogl::Window::Options();
@@ -108,7 +115,11 @@ int main() {
     // basic vertex shader, its inputs must respect the vertex array data
     auto vert_src = GLSL(330 core,
          precision highp float;
-         uniform mat4 camera;
+         layout (std140) uniform Frame {
+             mat4 camera;
+             vec3 camera_position;
+             float time;
+         };
          uniform mat4 model;
 
          layout (location = 0) in vec3 i_pos;
@@ -143,6 +154,9 @@ int main() {
     vert_shader.destroy();
     frag_shader.destroy();
 
+    // resolve the uniform once instead of looking it up by name on every draw
+    const auto model_uniform = shader.getUniform<glm::mat4>("model");
+
     Camera cam{};
     cam.pos = {10, 10, 2};
     cam.dir = {0, -1, 0};
@@ -151,7 +165,11 @@ int main() {
 
     glm::vec2 last_mouse_pos = window.getMousePosition();
 
+    // uploaded once per frame, whatever the number of shaders using it
+    auto frame_uniforms = sogl::UniformBuffer<FrameUniforms>("Frame");
+
     float cube_rotation = 0.f;
+    float time = 0.f;
     float dt = 0;
 
     auto update_fn = [&]() {
@@ -223,7 +241,7 @@ int main() {
     auto render_fn = [&]() {
         window.clear();
 
-        auto camera_matrix = cam.matrix();
+        frame_uniforms.update({cam.matrix(), cam.pos, time});
 
         // place the cube at (3, 3, 1) and rotate it
         auto model = glm::identity<glm::mat4>();
@@ -231,18 +249,16 @@ int main() {
         model = glm::rotate(model, glm::radians(cube_rotation), glm::vec3(0,0,1));
 
         shader.bind();
-        shader.setUniform("camera", camera_matrix);
-        shader.setUniform("model", model);
+        shader.setUniform(model_uniform, model);
         cube.bind();
         cube.render();
 
-        shader.bind();
-        shader.setUniform("camera", camera_matrix);
-        shader.setUniform("model", glm::identity<glm::mat4>());
+        shader.setUniform(model_uniform, glm::identity<glm::mat4>());
         axis.bind();
         axis.render();
 
         dt = static_cast<float>(window.display()) / 1000.f;
+        time += dt;
     };
 
 #if !defined(EMSCRIPTEN)
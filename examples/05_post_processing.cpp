@@ -54,6 +54,9 @@ int main() {
     vert_shader.destroy();
     frag_shader.destroy();
 
+    // linked programs are kept on disk, the next runs skip the compilation
+    sogl::Shader::setBinaryCacheDirectory("shader_cache");
+
     // let's create some post processing effects
     auto waves_post_process = sogl::PostProcess(GLSL(330 core,
         // uniforms are provided by the framebuffer
@@ -0,0 +1,129 @@
+// Created by Modar Nasser on 17/10/2026.
+
+// Compares the regular VertexArray uploads with the streaming mode on geometry rebuilt every frame.
+// Run it with LIBGL_ALWAYS_SOFTWARE=1 to benchmark Mesa llvmpipe.
+
+#include <sogl/sogl.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+
+int main() {
+    // create a window, without v-sync so that the frame time is not capped
+    auto window = sogl::Window(800, 600, "Streaming benchmark");
+
+    constexpr auto grid_size = 200;
+    constexpr auto frames_per_run = 300;
+
+    auto regular = sogl::VertexArray<glm::vec2, glm::vec4>(sogl::Primitive::Triangles);
+    auto streaming = sogl::VertexArray<glm::vec2, glm::vec4>(sogl::Primitive::Triangles);
+    streaming.setStreaming(3);
+
+    auto vert_src = GLSL(330 core,
+        precision highp float;
+        layout (location = 0) in vec2 i_pos;
+        layout (location = 1) in vec4 i_col;
+
+        out vec4 col;
+
+        void main() {
+            col = i_col;
+            gl_Position = vec4(i_pos.xy, 0, 1.0);
+        }
+    );
+    auto frag_src = GLSL(330 core,
+        precision highp float;
+        in vec4 col;
+        out vec4 fragColor;
+
+        void main() {
+            fragColor = col;
+        }
+    );
+
+    auto vert_shader = sogl::Shader::compileVertex(vert_src);
+    auto frag_shader = sogl::Shader::compileFragment(frag_src);
+    auto shader = sogl::Shader();
+    shader.load(vert_shader, frag_shader);
+    vert_shader.destroy();
+    frag_shader.destroy();
+
+    auto use_streaming = false;
+    auto frame = 0;
+    auto time = 0.f;
+    auto uploaded_bytes = 0.;
+    auto upload_time = std::chrono::duration<double>::zero();
+    auto run_start = std::chrono::high_resolution_clock::now();
+
+    auto render_fn = [&]() {
+        while (auto event = window.nextEvent()) {}
+
+        auto& vertex_array = use_streaming ? streaming : regular;
+
+        // rebuild a grid of animated quads, while streaming they are written straight into the mapped buffer
+        auto upload_start = std::chrono::high_resolution_clock::now();
+        vertex_array.clear();
+        const auto cell = 2.f / grid_size;
+        for (auto y = 0; y < grid_size; ++y) {
+            for (auto x = 0; x < grid_size; ++x) {
+                const auto px = -1.f + static_cast<float>(x) * cell;
+                const auto py = -1.f + static_cast<float>(y) * cell;
+                const auto wave = 0.5f + 0.5f * std::sin(time + static_cast<float>(x + y) * 0.1f);
+                const auto color = glm::vec4(wave, 1.f - wave, 0.5f, 1.f);
+                vertex_array.pushQuad({{
+                    {{px, py}, color},
+                    {{px + cell * wave, py}, color},
+                    {{px + cell * wave, py + cell * wave}, color},
+                    {{px, py + cell * wave}, color}
+                }});
+            }
+        }
+
+        vertex_array.bind();
+        upload_time += std::chrono::high_resolution_clock::now() - upload_start;
+
+        window.clear();
+        shader.bind();
+        uploaded_bytes += grid_size * grid_size * (4. * (sizeof(glm::vec2) + sizeof(glm::vec4)) + 6. * sizeof(unsigned));
+
+        vertex_array.render();
+        window.display();
+
+        time += 0.02f;
+        frame += 1;
+
+        if (frame == frames_per_run) {
+            auto run_time = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - run_start);
+            std::cout << (use_streaming ? "streaming" : "regular  ")
+                      << " | build and upload " << uploaded_bytes / (1024. * 1024.) / upload_time.count() << " MB/s"
+                      << " | frame time " << run_time.count() * 1000. / frames_per_run << " ms" << std::endl;
+
+            use_streaming = !use_streaming;
+            frame = 0;
+            uploaded_bytes = 0.;
+            upload_time = std::chrono::duration<double>::zero();
+            run_start = std::chrono::high_resolution_clock::now();
+        }
+    };
+
+#if !defined(EMSCRIPTEN)
+    // start main loop
+    while (window.isOpen()) {
+        render_fn();
+    }
+#else
+    struct App {
+        std::function<void()> render;
+    };
+    auto app = App{render_fn};
+    auto main_loop = [] (void* arg) {
+        auto* app = static_cast<App*>(arg);
+        app->render();
+    };
+    // start emscripten main loop
+    emscripten_set_main_loop_arg(main_loop, &app, 0, EM_TRUE);
+#endif
+    return 0;
+}
@@ -0,0 +1,132 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#include <sogl/sogl.hpp>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+
+int main() {
+    // create a window
+    auto options = sogl::Window::Options();
+    options.v_sync = true;
+    auto window = sogl::Window(800, 600, "Instancing demo", options);
+
+    constexpr auto grid_size = 50;
+
+    // vertex data is : vec3 position, float shading factor
+    // instance data is : mat4 model matrix, vec4 color
+    auto cubes = sogl::VertexArray<glm::vec3, float>::Instances<glm::mat4, glm::vec4>(sogl::Primitive::Triangles);
+    // bottom
+    cubes.pushQuad({{{{-1, -1, -1}, 0.4f}, {{1, -1, -1}, 0.4f}, {{1, -1, 1}, 0.4f}, {{-1, -1, 1}, 0.4f}}});
+    // top
+    cubes.pushQuad({{{{-1, 1, -1}, 1.0f}, {{1, 1, -1}, 1.0f}, {{1, 1, 1}, 1.0f}, {{-1, 1, 1}, 1.0f}}});
+    // left
+    cubes.pushQuad({{{{-1, -1, -1}, 0.6f}, {{-1, -1, 1}, 0.6f}, {{-1, 1, 1}, 0.6f}, {{-1, 1, -1}, 0.6f}}});
+    // right
+    cubes.pushQuad({{{{1, -1, -1}, 0.7f}, {{1, -1, 1}, 0.7f}, {{1, 1, 1}, 0.7f}, {{1, 1, -1}, 0.7f}}});
+    // back
+    cubes.pushQuad({{{{-1, -1, -1}, 0.8f}, {{1, -1, -1}, 0.8f}, {{1, 1, -1}, 0.8f}, {{-1, 1, -1}, 0.8f}}});
+    // front
+    cubes.pushQuad({{{{-1, -1, 1}, 0.9f}, {{1, -1, 1}, 0.9f}, {{1, 1, 1}, 0.9f}, {{-1, 1, 1}, 0.9f}}});
+
+    // one instance per cube of the grid, the geometry is not duplicated
+    for (auto z = 0; z < grid_size; ++z) {
+        for (auto x = 0; x < grid_size; ++x) {
+            auto position = glm::vec3(x - grid_size / 2, 0, z - grid_size / 2) * 3.f;
+            auto model = glm::translate(glm::identity<glm::mat4>(), position);
+            auto color = glm::vec4(static_cast<float>(x) / grid_size, 0.5f, static_cast<float>(z) / grid_size, 1.f);
+            cubes.pushInstance({model, color});
+        }
+    }
+
+    // instance attributes locations follow the vertex attributes ones, a mat4 uses 4 locations
+    auto vert_src = GLSL(330 core,
+         precision highp float;
+         uniform mat4 projection;
+         uniform mat4 camera;
+         uniform float time;
+
+         layout (location = 0) in vec3 i_pos;
+         layout (location = 1) in float i_shade;
+         layout (location = 2) in mat4 i_model;
+         layout (location = 6) in vec4 i_col;
+
+         out vec4 col;
+
+         void main() {
+             col = vec4(i_col.rgb * i_shade, i_col.a);
+             vec4 world_pos = i_model * vec4(i_pos.xyz, 1.0);
+             world_pos.y += sin(time + world_pos.x * 0.1 + world_pos.z * 0.1) * 2.0;
+             gl_Position = projection * camera * world_pos;
+         }
+    );
+    auto frag_src = GLSL(330 core,
+         precision highp float;
+         in vec4 col;
+         out vec4 fragColor;
+
+         void main() {
+             fragColor = col;
+         }
+    );
+    auto vert_shader = sogl::Shader::compileVertex(vert_src);
+    auto frag_shader = sogl::Shader::compileFragment(frag_src);
+
+    auto shader = sogl::Shader();
+    shader.load(vert_shader, frag_shader);
+
+    vert_shader.destroy();
+    frag_shader.destroy();
+
+    auto view_size = glm::vec2(window.getSize());
+
+    glm::mat4 projection = glm::perspective(glm::radians(50.0f), view_size.x/view_size.y, 0.1f, 500.0f);
+    glm::mat4 camera = glm::lookAt(glm::vec3(90, 60, 90), glm::vec3(0, 0, 0), glm::vec3(0, 1, 0));
+
+    float time = 0.f;
+
+    auto update_fn = [&]() {
+        while (const auto& event = window.nextEvent()) {
+            if (const auto& resize = event->as<sogl::Event::Resize>()) {
+                auto new_size = glm::vec2(window.getSize());
+                projection = glm::perspective(glm::radians(50.0f), new_size.x/new_size.y, 0.1f, 500.0f);
+            }
+        }
+    };
+
+    auto render_fn = [&]() {
+        window.clear();
+
+        shader.bind();
+        shader.setUniform("projection", projection);
+        shader.setUniform("camera", camera);
+        shader.setUniform("time", time);
+        cubes.bind();
+        cubes.renderInstanced();
+
+        auto dt_ms = window.display();
+        time += static_cast<float>(dt_ms) / 1000.f;
+    };
+
+#if !defined(EMSCRIPTEN)
+    // start main loop
+    while (window.isOpen()) {
+        update_fn();
+        render_fn();
+    }
+#else
+    struct App {
+        std::function<void()> update;
+        std::function<void()> render;
+    };
+    auto app = App{update_fn, render_fn};
+    auto main_loop = [] (void* arg) {
+        auto* app = static_cast<App*>(arg);
+        app->update();
+        app->render();
+    };
+    // start emscripten main loop
+    emscripten_set_main_loop_arg(main_loop, &app, 0, EM_TRUE);
+#endif
+    return 0;
+}
@@ -0,0 +1,150 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#include <sogl/sogl.hpp>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+struct Vertex {
+    glm::vec3 position;
+    glm::vec3 color;
+};
+
+// builds a box with its own vertices, every box is a separate mesh of the pool
+auto makeBox(glm::vec3 center, glm::vec3 half_size, glm::vec3 color) -> std::pair<std::vector<Vertex>, std::vector<unsigned>> {
+    constexpr std::array<std::array<int, 3>, 8> corners = {{
+        {-1, -1, -1}, {1, -1, -1}, {1, 1, -1}, {-1, 1, -1},
+        {-1, -1, 1}, {1, -1, 1}, {1, 1, 1}, {-1, 1, 1}
+    }};
+    std::vector<Vertex> vertices;
+    for (const auto& c : corners) {
+        auto corner = glm::vec3(c[0], c[1], c[2]);
+        auto shade = 0.6f + 0.4f * (corner.y + 1.f) / 2.f;
+        vertices.push_back({center + corner * half_size, color * shade});
+    }
+    std::vector<unsigned> indices = {
+        0, 1, 2, 2, 3, 0,  4, 5, 6, 6, 7, 4,
+        0, 4, 7, 7, 3, 0,  1, 5, 6, 6, 2, 1,
+        0, 1, 5, 5, 4, 0,  3, 2, 6, 6, 7, 3
+    };
+    return {vertices, indices};
+}
+
+int main() {
+    // create a window
+    auto options = sogl::Window::Options();
+    options.v_sync = true;
+    auto window = sogl::Window(800, 600, "Mesh pool demo", options);
+
+    constexpr auto grid_size = 70;
+
+    // all the meshes share a single VAO, VBO and IBO
+    auto pool = sogl::MeshPool<glm::vec3, glm::vec3>(sogl::Primitive::Triangles);
+    std::vector<sogl::MeshPool<glm::vec3, glm::vec3>::MeshId> meshes;
+    std::vector<glm::vec3> centers;
+    for (auto z = 0; z < grid_size; ++z) {
+        for (auto x = 0; x < grid_size; ++x) {
+            auto center = glm::vec3(x - grid_size / 2, 0, z - grid_size / 2) * 2.f;
+            auto height = 0.3f + 0.7f * static_cast<float>((x * 7 + z * 13) % 10) / 10.f;
+            auto color = glm::vec3(static_cast<float>(x) / grid_size, 0.5f, static_cast<float>(z) / grid_size);
+            auto [vertices, indices] = makeBox(center, {0.6f, height, 0.6f}, color);
+            meshes.push_back(pool.add(std::span<const Vertex>(vertices), std::span<const unsigned>(indices)));
+            centers.push_back(center);
+        }
+    }
+
+    auto vert_src = GLSL(330 core,
+         precision highp float;
+         uniform mat4 projection;
+         uniform mat4 camera;
+
+         layout (location = 0) in vec3 i_pos;
+         layout (location = 1) in vec3 i_col;
+
+         out vec4 col;
+
+         void main() {
+             col = vec4(i_col, 1.0);
+             gl_Position = projection * camera * vec4(i_pos, 1.0);
+         }
+    );
+    auto frag_src = GLSL(330 core,
+         precision highp float;
+         in vec4 col;
+         out vec4 fragColor;
+
+         void main() {
+             fragColor = col;
+         }
+    );
+    auto vert_shader = sogl::Shader::compileVertex(vert_src);
+    auto frag_shader = sogl::Shader::compileFragment(frag_src);
+
+    auto shader = sogl::Shader();
+    shader.load(vert_shader, frag_shader);
+
+    vert_shader.destroy();
+    frag_shader.destroy();
+
+    auto view_size = glm::vec2(window.getSize());
+
+    glm::mat4 projection = glm::perspective(glm::radians(50.0f), view_size.x/view_size.y, 0.1f, 500.0f);
+    glm::mat4 camera = glm::lookAt(glm::vec3(100, 80, 100), glm::vec3(0, 0, 0), glm::vec3(0, 1, 0));
+
+    float time = 0.f;
+
+    auto update_fn = [&]() {
+        while (const auto& event = window.nextEvent()) {
+            if (const auto& resize = event->as<sogl::Event::Resize>()) {
+                auto new_size = glm::vec2(window.getSize());
+                projection = glm::perspective(glm::radians(50.0f), new_size.x/new_size.y, 0.1f, 500.0f);
+            }
+        }
+    };
+
+    auto render_fn = [&]() {
+        window.clear();
+
+        shader.bind();
+        shader.setUniform("projection", projection);
+        shader.setUniform("camera", camera);
+
+        // the command buffer selects the boxes inside a growing and shrinking radius
+        auto radius = (0.5f + 0.5f * std::sin(time)) * grid_size * 1.5f;
+        pool.clearCommands();
+        for (std::size_t i = 0; i < meshes.size(); ++i) {
+            if (glm::length(centers[i]) < radius)
+                pool.pushCommand(meshes[i]);
+        }
+        pool.bind();
+        pool.render();
+
+        auto dt_ms = window.display();
+        time += static_cast<float>(dt_ms) / 1000.f;
+    };
+
+#if !defined(EMSCRIPTEN)
+    // start main loop
+    while (window.isOpen()) {
+        update_fn();
+        render_fn();
+    }
+#else
+    struct App {
+        std::function<void()> update;
+        std::function<void()> render;
+    };
+    auto app = App{update_fn, render_fn};
+    auto main_loop = [] (void* arg) {
+        auto* app = static_cast<App*>(arg);
+        app->update();
+        app->render();
+    };
+    // start emscripten main loop
+    emscripten_set_main_loop_arg(main_loop, &app, 0, EM_TRUE);
+#endif
+    return 0;
+}
@@ -0,0 +1,121 @@
+// Created by Modar Nasser on 17/10/2026.
+
+// Draws 100k bouncing sprites with two textures through a SpriteBatch.
+// Run it with LIBGL_ALWAYS_SOFTWARE=1 to benchmark Mesa llvmpipe.
+
+#include <sogl/sogl.hpp>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+auto makeCheckerTexture(sogl::Texture& texture, glm::vec<3, std::uint8_t> color) {
+    constexpr auto size = 16;
+    std::array<std::uint8_t, size * size * 4> pixels = {};
+    for (auto y = 0; y < size; ++y) {
+        for (auto x = 0; x < size; ++x) {
+            auto* pixel = pixels.data() + (y * size + x) * 4;
+            const auto on = ((x / 4) + (y / 4)) % 2 == 0;
+            pixel[0] = on ? color.r : 255;
+            pixel[1] = on ? color.g : 255;
+            pixel[2] = on ? color.b : 255;
+            pixel[3] = 255;
+        }
+    }
+    texture.create(size, size);
+    texture.copy(pixels.data(), 0, 0, size, size);
+}
+
+int main() {
+    // create a window, without v-sync so that the frame time is not capped
+    auto window = sogl::Window(800, 600, "Sprite batch demo");
+
+    constexpr auto sprite_count = 100'000;
+
+    auto textures = std::array<sogl::Texture, 2>();
+    makeCheckerTexture(textures[0], {230, 80, 80});
+    makeCheckerTexture(textures[1], {80, 120, 230});
+
+    struct Body {
+        glm::vec2 position;
+        glm::vec2 velocity;
+    };
+    auto rng = std::mt19937(42);
+    auto random = std::uniform_real_distribution<float>(0.f, 1.f);
+    auto bodies = std::vector<Body>(sprite_count);
+    for (auto& body : bodies) {
+        body.position = glm::vec2(random(rng) * 800.f, random(rng) * 600.f);
+        body.velocity = glm::vec2(random(rng) - 0.5f, random(rng) - 0.5f) * 200.f;
+    }
+
+    auto batch = sogl::SpriteBatch();
+    auto projection = glm::ortho(0.f, 800.f, 600.f, 0.f);
+
+    auto frame = 0;
+    auto frame_start = std::chrono::high_resolution_clock::now();
+
+    auto render_fn = [&]() {
+        while (const auto& event = window.nextEvent()) {
+            if (const auto& resize = event->as<sogl::Event::Resize>()) {
+                auto size = glm::vec2(window.getSize());
+                projection = glm::ortho(0.f, size.x, size.y, 0.f);
+            }
+        }
+
+        window.clear();
+
+        batch.begin();
+        const auto size = glm::vec2(window.getSize());
+        for (std::size_t i = 0; i < bodies.size(); ++i) {
+            auto& body = bodies[i];
+            body.position += body.velocity * (1.f / 60.f);
+            if (body.position.x < 0.f || body.position.x > size.x)
+                body.velocity.x = -body.velocity.x;
+            if (body.position.y < 0.f || body.position.y > size.y)
+                body.velocity.y = -body.velocity.y;
+
+            // sprites alternate between the two textures, the batch groups them back together
+            auto sprite = sogl::Sprite();
+            sprite.texture = &textures[i % 2];
+            sprite.rect = {body.position.x - 4.f, body.position.y - 4.f, 8.f, 8.f};
+            batch.draw(sprite);
+        }
+        batch.end(projection);
+
+        window.display();
+
+        if (++frame == 120) {
+            auto elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - frame_start);
+            const auto& stats = batch.getStats();
+            std::cout << stats.sprites << " sprites | " << stats.draw_calls << " draw calls"
+                      << " | frame time " << elapsed.count() * 1000. / frame << " ms" << std::endl;
+            frame = 0;
+            frame_start = std::chrono::high_resolution_clock::now();
+        }
+    };
+
+#if !defined(EMSCRIPTEN)
+    // start main loop
+    while (window.isOpen()) {
+        render_fn();
+    }
+#else
+    struct App {
+        std::function<void()> render;
+    };
+    auto app = App{render_fn};
+    auto main_loop = [] (void* arg) {
+        auto* app = static_cast<App*>(arg);
+        app->render();
+    };
+    // start emscripten main loop
+    emscripten_set_main_loop_arg(main_loop, &app, 0, EM_TRUE);
+#endif
+    return 0;
+}
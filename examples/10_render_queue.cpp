@@ -0,0 +1,174 @@
+// Created by Modar Nasser on 17/10/2026.
+
+// Submits a grid of shapes in a scattered order through a RenderQueue and
+// prints how many state changes the sort saved.
+
+#include <sogl/sogl.hpp>
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+constexpr auto grid_size = 30;
+constexpr auto cell = 2.f / grid_size;
+
+auto makeStripesTexture(sogl::Texture& texture, glm::vec<3, std::uint8_t> color) {
+    constexpr auto size = 16;
+    std::array<std::uint8_t, size * size * 4> pixels = {};
+    for (auto y = 0; y < size; ++y) {
+        for (auto x = 0; x < size; ++x) {
+            auto* pixel = pixels.data() + (y * size + x) * 4;
+            const auto on = (x / 4) % 2 == 0;
+            pixel[0] = on ? color.r : 40;
+            pixel[1] = on ? color.g : 40;
+            pixel[2] = on ? color.b : 40;
+            pixel[3] = 255;
+        }
+    }
+    texture.create(size, size);
+    texture.copy(pixels.data(), 0, 0, size, size);
+}
+
+int main() {
+    // create a window
+    auto options = sogl::Window::Options();
+    options.v_sync = true;
+    auto window = sogl::Window(800, 600, "Render queue demo", options);
+
+    auto textures = std::array<sogl::Texture, 3>();
+    makeStripesTexture(textures[0], {230, 80, 80});
+    makeStripesTexture(textures[1], {80, 200, 80});
+    makeStripesTexture(textures[2], {80, 120, 230});
+
+    using Mesh = sogl::VertexArray<glm::vec2, glm::vec2>;
+    auto quad = Mesh(sogl::Primitive::Triangles);
+    quad.pushQuad({{
+        {{-0.4f, -0.4f}, {0.f, 0.f}},
+        {{0.4f, -0.4f}, {1.f, 0.f}},
+        {{0.4f, 0.4f}, {1.f, 1.f}},
+        {{-0.4f, 0.4f}, {0.f, 1.f}}
+    }});
+    auto triangle = Mesh(sogl::Primitive::Triangles);
+    triangle.pushTriangle({{
+        {{-0.4f, -0.4f}, {0.f, 0.f}},
+        {{0.4f, -0.4f}, {1.f, 0.f}},
+        {{0.f, 0.4f}, {0.5f, 1.f}}
+    }});
+    const auto meshes = std::array<const Mesh*, 2>{&quad, &triangle};
+
+    auto vert_src = GLSL(330 core,
+         precision highp float;
+         uniform vec2 offset;
+         uniform float scale;
+
+         layout (location = 0) in vec2 i_pos;
+         layout (location = 1) in vec2 i_uv;
+
+         out vec2 uv;
+
+         void main() {
+             uv = i_uv;
+             gl_Position = vec4(i_pos * scale + offset, 0.0, 1.0);
+         }
+    );
+    auto color_src = GLSL(330 core,
+         precision highp float;
+         uniform sampler2D tex;
+         in vec2 uv;
+         out vec4 fragColor;
+
+         void main() {
+             fragColor = texture(tex, uv);
+         }
+    );
+    auto gray_src = GLSL(330 core,
+         precision highp float;
+         uniform sampler2D tex;
+         in vec2 uv;
+         out vec4 fragColor;
+
+         void main() {
+             vec4 color = texture(tex, uv);
+             fragColor = vec4(vec3(dot(color.rgb, vec3(0.299, 0.587, 0.114))), color.a);
+         }
+    );
+    auto vert_shader = sogl::Shader::compileVertex(vert_src);
+    auto color_shader = sogl::Shader::compileFragment(color_src);
+    auto gray_shader = sogl::Shader::compileFragment(gray_src);
+
+    auto shaders = std::array<sogl::Shader, 2>();
+    shaders[0].load(vert_shader, color_shader);
+    shaders[1].load(vert_shader, gray_shader);
+
+    vert_shader.destroy();
+    color_shader.destroy();
+    gray_shader.destroy();
+
+    // every cell picks its shader, texture and mesh so that neighbours never share all three
+    struct Object {
+        glm::vec2 offset;
+        const sogl::Shader* shader;
+        const sogl::Texture* texture;
+        const Mesh* mesh;
+    };
+    auto objects = std::vector<Object>();
+    for (auto y = 0; y < grid_size; ++y) {
+        for (auto x = 0; x < grid_size; ++x) {
+            const auto i = y * grid_size + x;
+            const auto offset = glm::vec2(-1.f + (x + 0.5f) * cell, -1.f + (y + 0.5f) * cell);
+            objects.push_back({offset, &shaders[i % 2], &textures[i % 3], meshes[(i / 6) % 2]});
+        }
+    }
+
+    const auto set_uniforms = [](const sogl::Shader& shader, const void* user_data) {
+        shader.setUniform("offset", static_cast<const Object*>(user_data)->offset);
+        shader.setUniform("scale", cell);
+    };
+
+    auto queue = sogl::RenderQueue();
+    auto frame = 0;
+
+    auto render_fn = [&]() {
+        while (window.nextEvent()) {}
+
+        window.clear();
+
+        for (const auto& object : objects) {
+            queue.submit(*object.mesh, *object.shader, {
+                .texture = object.texture,
+                .uniforms = set_uniforms,
+                .user_data = &object
+            });
+        }
+        queue.execute();
+
+        window.display();
+
+        if (++frame == 120) {
+            const auto& stats = queue.getStats();
+            std::cout << stats.draws << " draws | " << stats.state_changes_unsorted << " state changes unsorted | "
+                      << stats.state_changes << " sorted" << std::endl;
+            frame = 0;
+        }
+    };
+
+#if !defined(EMSCRIPTEN)
+    // start main loop
+    while (window.isOpen()) {
+        render_fn();
+    }
+#else
+    struct App {
+        std::function<void()> render;
+    };
+    auto app = App{render_fn};
+    auto main_loop = [] (void* arg) {
+        auto* app = static_cast<App*>(arg);
+        app->render();
+    };
+    // start emscripten main loop
+    emscripten_set_main_loop_arg(main_loop, &app, 0, EM_TRUE);
+#endif
+    return 0;
+}
@@ -0,0 +1,138 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#include <sogl/sogl.hpp>
+
+#include <random>
+
+
+// laid out as std430 : two vec2, no padding needed
+struct Particle {
+    glm::vec2 position;
+    glm::vec2 velocity;
+};
+
+int main() {
+    // create a window
+    auto options = sogl::Window::Options();
+    options.v_sync = true;
+    auto window = sogl::Window(800, 600, "Compute demo", options);
+
+    constexpr auto particle_count = 100000;
+    constexpr auto group_size = 64;
+
+    // the particles live on the GPU, the CPU only fills them once
+    auto rng = std::mt19937(42);
+    auto dist = std::uniform_real_distribution<float>(-1.f, 1.f);
+    auto initial_particles = std::vector<Particle>(particle_count);
+    for (auto& particle : initial_particles) {
+        particle.position = {dist(rng), dist(rng) * 0.5f + 0.5f};
+        particle.velocity = {dist(rng) * 0.5f, dist(rng) * 0.2f};
+    }
+    auto particles = sogl::StorageBuffer<Particle>("Particles", particle_count);
+    particles.update(initial_particles);
+
+    // one point per particle, its position is read from the storage buffer
+    // vertex data is : float brightness
+    auto points = sogl::VertexArray<float>(sogl::Primitive::Points);
+    for (auto i = 0; i < particle_count; ++i) {
+        points.push({0.5f + 0.5f * static_cast<float>(i % 7) / 6.f});
+    }
+
+    auto compute_src = GLSL(430 core,
+        layout(local_size_x = 64) in;
+
+        struct Particle {
+            vec2 position;
+            vec2 velocity;
+        };
+        layout(std430) buffer Particles {
+            Particle particles[];
+        };
+        uniform float dt;
+
+        void main() {
+            uint i = gl_GlobalInvocationID.x;
+            if (i >= uint(particles.length()))
+                return;
+
+            Particle p = particles[i];
+            p.velocity.y -= 0.8 * dt;
+            p.position += p.velocity * dt;
+            // bounce on the bottom and on the sides
+            if (p.position.y < -1.0) {
+                p.position.y = -1.0;
+                p.velocity.y = abs(p.velocity.y) * 0.9;
+            }
+            if (abs(p.position.x) > 1.0) {
+                p.position.x = clamp(p.position.x, -1.0, 1.0);
+                p.velocity.x = -p.velocity.x;
+            }
+            particles[i] = p;
+        }
+    );
+    auto vert_src = GLSL(430 core,
+        precision highp float;
+
+        struct Particle {
+            vec2 position;
+            vec2 velocity;
+        };
+        layout(std430) readonly buffer Particles {
+            Particle particles[];
+        };
+
+        layout (location = 0) in float i_brightness;
+
+        out vec4 col;
+
+        void main() {
+            gl_Position = vec4(particles[gl_VertexID].position, 0.0, 1.0);
+            col = vec4(vec3(0.4, 0.7, 1.0) * i_brightness, 1.0);
+        }
+    );
+    auto frag_src = GLSL(430 core,
+        precision highp float;
+        in vec4 col;
+        out vec4 fragColor;
+
+        void main() {
+            fragColor = col;
+        }
+    );
+
+    auto compute_shader = sogl::Shader::compileCompute(compute_src);
+    auto compute = sogl::Shader();
+    compute.load(compute_shader);
+    compute_shader.destroy();
+
+    auto vert_shader = sogl::Shader::compileVertex(vert_src);
+    auto frag_shader = sogl::Shader::compileFragment(frag_src);
+    auto shader = sogl::Shader();
+    shader.load(vert_shader, frag_shader);
+    vert_shader.destroy();
+    frag_shader.destroy();
+
+    auto dt = 0.f;
+
+    // start main loop
+    while (window.isOpen()) {
+        while (window.nextEvent()) {}
+
+        // update the particles, then make the writes visible to the vertex shader
+        compute.bind();
+        compute.setUniform("dt", dt);
+        compute.dispatch((particle_count + group_size - 1) / group_size);
+        sogl::Shader::memoryBarrier(sogl::Barrier::ShaderStorage);
+
+        window.clear();
+
+        shader.bind();
+        points.bind();
+        points.render();
+
+        auto dt_ms = window.display();
+        dt = static_cast<float>(dt_ms) / 1000.f;
+    }
+
+    return 0;
+}
@@ -0,0 +1,198 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#pragma once
+
+#include <sogl/GlObject.hpp>
+#include <sogl/GlState.hpp>
+
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sogl {
+
+    // what the buffer is bound to for drawing, the uploads never touch these bindings
+    enum class BufferTarget : GLenum {
+        Vertex = GL_ARRAY_BUFFER,
+        Index = GL_ELEMENT_ARRAY_BUFFER,    // stored in the vertex array bound at that time
+        Uniform = GL_UNIFORM_BUFFER,
+        PixelPack = GL_PIXEL_PACK_BUFFER,
+        PixelUnpack = GL_PIXEL_UNPACK_BUFFER,
+        DrawIndirect = GL_DRAW_INDIRECT_BUFFER,
+#if !defined(EMSCRIPTEN)
+        ShaderStorage = GL_SHADER_STORAGE_BUFFER,
+#endif
+    };
+
+    // hint given to the driver for mutable buffers
+    enum class BufferUsage : GLenum {
+        StaticDraw = GL_STATIC_DRAW,
+        DynamicDraw = GL_DYNAMIC_DRAW,
+        StreamDraw = GL_STREAM_DRAW,
+        StaticRead = GL_STATIC_READ,
+        DynamicRead = GL_DYNAMIC_READ,
+        StreamRead = GL_STREAM_READ,
+        StaticCopy = GL_STATIC_COPY,
+        DynamicCopy = GL_DYNAMIC_COPY,
+        StreamCopy = GL_STREAM_COPY,
+    };
+
+    enum class BufferAccess : GLbitfield {
+        Read = GL_MAP_READ_BIT,
+        Write = GL_MAP_WRITE_BIT,
+        InvalidateRange = GL_MAP_INVALIDATE_RANGE_BIT,
+        InvalidateBuffer = GL_MAP_INVALIDATE_BUFFER_BIT,
+        FlushExplicit = GL_MAP_FLUSH_EXPLICIT_BIT,
+        Unsynchronized = GL_MAP_UNSYNCHRONIZED_BIT,
+#if !defined(EMSCRIPTEN)
+        Persistent = GL_MAP_PERSISTENT_BIT,
+        Coherent = GL_MAP_COHERENT_BIT,
+#endif
+    };
+
+    auto operator|(const BufferAccess& left, const BufferAccess& right) -> BufferAccess;
+
+#if !defined(EMSCRIPTEN)
+    // flags of an immutable data store, a mapping may only ask for the access given here
+    enum class BufferStorage : GLbitfield {
+        None = 0,
+        Dynamic = GL_DYNAMIC_STORAGE_BIT,   // needed by update
+        Read = GL_MAP_READ_BIT,
+        Write = GL_MAP_WRITE_BIT,
+        Persistent = GL_MAP_PERSISTENT_BIT,
+        Coherent = GL_MAP_COHERENT_BIT,
+        Client = GL_CLIENT_STORAGE_BIT,
+    };
+
+    auto operator|(const BufferStorage& left, const BufferStorage& right) -> BufferStorage;
+#endif
+
+    namespace detail {
+        // first-fit allocator over [0, capacity), freed blocks are merged with their neighbours
+        class RangeAllocator {
+        public:
+            explicit RangeAllocator(std::size_t capacity = 0);
+
+            auto allocate(std::size_t size) -> std::optional<std::size_t>;
+            void free(std::size_t offset, std::size_t size);
+            void grow(std::size_t capacity);
+            // frees everything, allocations then go one after the other
+            void reset();
+
+            [[nodiscard]] auto getCapacity() const -> std::size_t;
+
+        private:
+            std::vector<std::pair<std::size_t, std::size_t>> m_free;  // sorted (offset, size) blocks
+            std::size_t m_capacity;
+        };
+
+        auto buffer_storage_supported() -> bool;
+    }
+
+    // a GL buffer holding count elements of T. sizes, offsets and ranges are given in elements.
+    // uploads, reads and copies go through the copy targets so that no draw binding is changed
+    template <typename T>
+    class Buffer : public GlObject {
+        static_assert(std::is_trivially_copyable_v<T>, "buffer data must be trivially copyable");
+
+    public:
+        Buffer() = default;
+        explicit Buffer(std::size_t count, BufferUsage usage = BufferUsage::DynamicDraw);
+        explicit Buffer(std::span<const T> data, BufferUsage usage = BufferUsage::StaticDraw);
+        ~Buffer();
+        Buffer(const Buffer&) = delete;
+        Buffer(Buffer&& other) noexcept;
+        Buffer& operator=(const Buffer&) = delete;
+        Buffer& operator=(Buffer&& other) noexcept;
+
+        // (re)allocates a mutable data store, the name of the buffer is kept
+        void create(std::size_t count, BufferUsage usage = BufferUsage::DynamicDraw, const T* data = nullptr);
+#if !defined(EMSCRIPTEN)
+        // allocates an immutable data store under a new name, needs GL 4.4 or GL_ARB_buffer_storage.
+        // without it the store is mutable and can't be mapped persistently
+        void create(std::size_t count, BufferStorage storage, const T* data = nullptr);
+#endif
+        void destroy();
+
+        // keeps the first elements, they are copied to a new name unless the buffer was empty. the buffer is unmapped
+        void resize(std::size_t count);
+
+        // the content becomes undefined, the driver hands out fresh memory instead of waiting for the draws
+        void invalidate();
+
+        void update(std::span<const T> data, std::size_t first = 0);
+
+#if !defined(EMSCRIPTEN)
+        // waits for the GPU
+        [[nodiscard]] auto read(std::size_t first = 0, std::size_t count = ~std::size_t(0)) const -> std::vector<T>;
+#endif
+
+        // the span is valid until unmap, or for the lifetime of the store with a persistent mapping.
+        // it is empty when the driver refused the mapping
+        [[nodiscard]] auto map(BufferAccess access) -> std::span<T>;
+        [[nodiscard]] auto mapRange(std::size_t first, std::size_t count, BufferAccess access) -> std::span<T>;
+        // with BufferAccess::FlushExplicit, first is relative to the mapped range
+        void flush(std::size_t first, std::size_t count);
+        // false when the content was lost while mapped and must be uploaded again
+        auto unmap() -> bool;
+        [[nodiscard]] auto isMapped() const -> bool;
+
+        void copyTo(Buffer& destination, std::size_t first = 0, std::size_t destination_first = 0,
+                    std::size_t count = ~std::size_t(0)) const;
+
+        void bind(BufferTarget target) const;
+        // binds the whole buffer or a range of it to an indexed binding point of a uniform or storage target,
+        // a range must start on a multiple of the offset alignment of the target
+        void bindBase(BufferTarget target, unsigned index) const;
+        void bindRange(BufferTarget target, unsigned index, std::size_t first, std::size_t count) const;
+
+        [[nodiscard]] auto getSize() const -> std::size_t;
+        [[nodiscard]] auto getId() const -> unsigned;
+
+        [[nodiscard]] static auto isStorageSupported() -> bool;
+
+    private:
+        std::size_t m_size = 0;
+        GLenum m_usage = GL_DYNAMIC_DRAW;
+        GLbitfield m_storage = 0;
+        bool m_immutable = false;
+        std::span<T> m_mapped;
+    };
+
+    // hands out ranges of a single buffer, freed ranges are reused first-fit and the buffer grows
+    // when none is large enough, keeping its content. growing moves the content to a new buffer name,
+    // compare getBuffer().getId() to know when the draw bindings must be done again.
+    // reset frees everything at once, for a linear allocator emptied every frame
+    template <typename T>
+    class BufferAllocator {
+    public:
+        struct Range {
+            std::size_t first = 0;
+            std::size_t count = 0;
+        };
+
+        explicit BufferAllocator(std::size_t capacity, BufferUsage usage = BufferUsage::DynamicDraw);
+
+        auto allocate(std::size_t count) -> Range;
+        void free(const Range& range);
+        void reset();
+
+        [[nodiscard]] auto getBuffer() -> Buffer<T>&;
+        [[nodiscard]] auto getBuffer() const -> const Buffer<T>&;
+        [[nodiscard]] auto getCapacity() const -> std::size_t;
+
+    private:
+        Buffer<T> m_buffer;
+        detail::RangeAllocator m_ranges;
+    };
+
+}
+
+#include <sogl/Buffer.tpp>
@@ -0,0 +1,292 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#pragma once
+
+namespace sogl {
+
+    template <typename T>
+    Buffer<T>::Buffer(std::size_t count, BufferUsage usage) {
+        create(count, usage);
+    }
+
+    template <typename T>
+    Buffer<T>::Buffer(std::span<const T> data, BufferUsage usage) {
+        create(data.size(), usage, data.data());
+    }
+
+    template <typename T>
+    Buffer<T>::~Buffer() {
+        destroy();
+    }
+
+    template <typename T>
+    Buffer<T>::Buffer(Buffer&& other) noexcept :
+    GlObject(std::move(other)),
+    m_size(std::exchange(other.m_size, 0)),
+    m_usage(other.m_usage),
+    m_storage(other.m_storage),
+    m_immutable(std::exchange(other.m_immutable, false)),
+    m_mapped(std::exchange(other.m_mapped, {})) {}
+
+    template <typename T>
+    auto Buffer<T>::operator=(Buffer&& other) noexcept -> Buffer& {
+        if (this != &other) {
+            destroy();
+            GlObject::operator=(std::move(other));
+            m_size = std::exchange(other.m_size, 0);
+            m_usage = other.m_usage;
+            m_storage = other.m_storage;
+            m_immutable = std::exchange(other.m_immutable, false);
+            m_mapped = std::exchange(other.m_mapped, {});
+        }
+        return *this;
+    }
+
+    template <typename T>
+    void Buffer<T>::create(std::size_t count, BufferUsage usage, const T* data) {
+        // immutable stores can't be respecified
+        if (m_immutable) {
+            destroy();
+        }
+        if (handle == 0) {
+            glGenBuffers(1, &handle);
+        }
+        GlState::current().bindBuffer(GL_COPY_WRITE_BUFFER, handle);
+        glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(count * sizeof(T)), data, static_cast<GLenum>(usage));
+        m_size = count;
+        m_usage = static_cast<GLenum>(usage);
+        m_storage = 0;
+        m_mapped = {};
+    }
+
+#if !defined(EMSCRIPTEN)
+    template <typename T>
+    void Buffer<T>::create(std::size_t count, BufferStorage storage, const T* data) {
+        destroy();
+        glGenBuffers(1, &handle);
+        GlState::current().bindBuffer(GL_COPY_WRITE_BUFFER, handle);
+
+        const auto flags = static_cast<GLbitfield>(storage);
+        const auto size = static_cast<GLsizeiptr>(count * sizeof(T));
+        // an immutable store can't be empty
+        m_immutable = count > 0 && isStorageSupported();
+        if (m_immutable) {
+            glBufferStorage(GL_COPY_WRITE_BUFFER, size, data, flags);
+        } else {
+            m_usage = flags & GL_MAP_READ_BIT ? GL_DYNAMIC_READ : flags & GL_DYNAMIC_STORAGE_BIT ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW;
+            glBufferData(GL_COPY_WRITE_BUFFER, size, data, m_usage);
+        }
+        m_size = count;
+        m_storage = flags;
+    }
+#endif
+
+    template <typename T>
+    void Buffer<T>::destroy() {
+        // deleting a buffer also unmaps it
+        if (handle != 0) {
+            GlState::current().deleteBuffer(handle);
+            handle = 0;
+        }
+        m_size = 0;
+        m_immutable = false;
+        m_mapped = {};
+    }
+
+    template <typename T>
+    void Buffer<T>::resize(std::size_t count) {
+        if (handle == 0 || (m_size == 0 && !m_immutable)) {
+            create(count, BufferUsage(m_usage));
+            return;
+        }
+
+        auto resized = Buffer();
+#if !defined(EMSCRIPTEN)
+        if (m_storage != 0) {
+            resized.create(count, BufferStorage(m_storage));
+        } else
+#endif
+        {
+            resized.create(count, BufferUsage(m_usage));
+        }
+        copyTo(resized, 0, 0, std::min(count, m_size));
+        *this = std::move(resized);
+    }
+
+    template <typename T>
+    void Buffer<T>::invalidate() {
+        if (handle == 0)
+            return;
+
+        if (!m_immutable) {
+            // orphaning, the old store lives until the draws using it are done
+            GlState::current().bindBuffer(GL_COPY_WRITE_BUFFER, handle);
+            glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(m_size * sizeof(T)), nullptr, m_usage);
+            m_mapped = {};
+            return;
+        }
+#if !defined(EMSCRIPTEN)
+        if (GLEW_ARB_invalidate_subdata) {
+            glInvalidateBufferData(handle);
+        }
+#endif
+    }
+
+    template <typename T>
+    void Buffer<T>::update(std::span<const T> data, std::size_t first) {
+        assert(first + data.size() <= m_size);
+        if (data.empty())
+            return;
+
+        GlState::current().bindBuffer(GL_COPY_WRITE_BUFFER, handle);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(first * sizeof(T)),
+                        static_cast<GLsizeiptr>(data.size_bytes()), data.data());
+    }
+
+#if !defined(EMSCRIPTEN)
+    template <typename T>
+    auto Buffer<T>::read(std::size_t first, std::size_t count) const -> std::vector<T> {
+        first = std::min(first, m_size);
+        count = std::min(count, m_size - first);
+        auto data = std::vector<T>(count);
+        if (count == 0)
+            return data;
+
+        GlState::current().bindBuffer(GL_COPY_READ_BUFFER, handle);
+        glGetBufferSubData(GL_COPY_READ_BUFFER, static_cast<GLintptr>(first * sizeof(T)),
+                           static_cast<GLsizeiptr>(count * sizeof(T)), data.data());
+        return data;
+    }
+#endif
+
+    template <typename T>
+    auto Buffer<T>::map(BufferAccess access) -> std::span<T> {
+        return mapRange(0, m_size, access);
+    }
+
+    template <typename T>
+    auto Buffer<T>::mapRange(std::size_t first, std::size_t count, BufferAccess access) -> std::span<T> {
+        assert(!isMapped() && first + count <= m_size);
+        if (count == 0)
+            return {};
+
+        GlState::current().bindBuffer(GL_COPY_WRITE_BUFFER, handle);
+        auto* data = glMapBufferRange(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(first * sizeof(T)),
+                                      static_cast<GLsizeiptr>(count * sizeof(T)), static_cast<GLbitfield>(access));
+        if (data != nullptr) {
+            m_mapped = std::span<T>(static_cast<T*>(data), count);
+        }
+        return m_mapped;
+    }
+
+    template <typename T>
+    void Buffer<T>::flush(std::size_t first, std::size_t count) {
+        assert(isMapped() && first + count <= m_mapped.size());
+        GlState::current().bindBuffer(GL_COPY_WRITE_BUFFER, handle);
+        glFlushMappedBufferRange(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(first * sizeof(T)),
+                                 static_cast<GLsizeiptr>(count * sizeof(T)));
+    }
+
+    template <typename T>
+    auto Buffer<T>::unmap() -> bool {
+        if (!isMapped())
+            return true;
+
+        m_mapped = {};
+        GlState::current().bindBuffer(GL_COPY_WRITE_BUFFER, handle);
+        return glUnmapBuffer(GL_COPY_WRITE_BUFFER) == GL_TRUE;
+    }
+
+    template <typename T>
+    auto Buffer<T>::isMapped() const -> bool {
+        return !m_mapped.empty();
+    }
+
+    template <typename T>
+    void Buffer<T>::copyTo(Buffer& destination, std::size_t first, std::size_t destination_first, std::size_t count) const {
+        first = std::min(first, m_size);
+        count = std::min(count, m_size - first);
+        assert(destination_first + count <= destination.m_size);
+        if (count == 0)
+            return;
+
+        GlState::current().bindBuffer(GL_COPY_READ_BUFFER, handle);
+        GlState::current().bindBuffer(GL_COPY_WRITE_BUFFER, destination.handle);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(first * sizeof(T)),
+                            static_cast<GLintptr>(destination_first * sizeof(T)), static_cast<GLsizeiptr>(count * sizeof(T)));
+    }
+
+    template <typename T>
+    void Buffer<T>::bind(BufferTarget target) const {
+        GlState::current().bindBuffer(static_cast<GLenum>(target), handle);
+    }
+
+    template <typename T>
+    void Buffer<T>::bindBase(BufferTarget target, unsigned index) const {
+        GlState::current().bindBufferBase(static_cast<GLenum>(target), index, handle);
+    }
+
+    template <typename T>
+    void Buffer<T>::bindRange(BufferTarget target, unsigned index, std::size_t first, std::size_t count) const {
+        GlState::current().bindBufferRange(static_cast<GLenum>(target), index, handle, first * sizeof(T), count * sizeof(T));
+    }
+
+    template <typename T>
+    auto Buffer<T>::getSize() const -> std::size_t {
+        return m_size;
+    }
+
+    template <typename T>
+    auto Buffer<T>::getId() const -> unsigned {
+        return handle;
+    }
+
+    template <typename T>
+    auto Buffer<T>::isStorageSupported() -> bool {
+        return detail::buffer_storage_supported();
+    }
+
+    template <typename T>
+    BufferAllocator<T>::BufferAllocator(std::size_t capacity, BufferUsage usage) :
+    m_buffer(capacity, usage),
+    m_ranges(capacity) {}
+
+    template <typename T>
+    auto BufferAllocator<T>::allocate(std::size_t count) -> Range {
+        auto first = m_ranges.allocate(count);
+        if (!first) {
+            // grow geometrically, the ranges already handed out keep their content
+            const auto capacity = std::max(m_ranges.getCapacity() * 2, m_ranges.getCapacity() + count);
+            m_buffer.resize(capacity);
+            m_ranges.grow(capacity);
+            first = m_ranges.allocate(count);
+        }
+        return {*first, count};
+    }
+
+    template <typename T>
+    void BufferAllocator<T>::free(const Range& range) {
+        m_ranges.free(range.first, range.count);
+    }
+
+    template <typename T>
+    void BufferAllocator<T>::reset() {
+        m_ranges.reset();
+    }
+
+    template <typename T>
+    auto BufferAllocator<T>::getBuffer() -> Buffer<T>& {
+        return m_buffer;
+    }
+
+    template <typename T>
+    auto BufferAllocator<T>::getBuffer() const -> const Buffer<T>& {
+        return m_buffer;
+    }
+
+    template <typename T>
+    auto BufferAllocator<T>::getCapacity() const -> std::size_t {
+        return m_ranges.getCapacity();
+    }
+
+}
@@ -6,8 +6,12 @@
 
 #include <glm/vec2.hpp>
 
+#include <concepts>
 #include <filesystem>
+#include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 
 namespace sogl {
@@ -41,13 +45,24 @@ namespace sogl {
         void shapeText(const char8_t* string, int size, std::vector<Glyph::Shape>& glyphs);
         void shapeText(const std::wstring& string, int size, std::vector<Glyph::Shape>& glyphs);
 
+        // calls fn(const Glyph::Shape&) for each glyph of an utf8 string, instead of storing them
+        template <typename GlyphFn> requires std::invocable<GlyphFn&, const Glyph::Shape&>
+        void shapeText(std::string_view string, int size, GlyphFn fn) {
+            shapeUtf8(string, size, [](void* user_data, const Glyph::Shape& shape) {
+                (*static_cast<GlyphFn*>(user_data))(shape);
+            }, &fn);
+        }
+
         auto getGlyph(std::uint32_t codepoint, int size) -> const Glyph&;
 
         [[nodiscard]] auto getTexture(int size) const -> const Texture&;
 
     private:
+        using GlyphCallback = void (*)(void* user_data, const Glyph::Shape& shape);
+
         void setPixelSize(int size);
-        void shape(void* buffer, int size, std::vector<Glyph::Shape>& vertices);
+        void shapeUtf8(std::string_view string, int size, GlyphCallback callback, void* user_data);
+        void shape(void* buffer, int size, GlyphCallback callback, void* user_data);
 
         struct GlyphPage {
             std::unordered_map<std::uint32_t, Glyph> glyphs;
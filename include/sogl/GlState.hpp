@@ -0,0 +1,99 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#pragma once
+
+#include <glm/vec4.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+namespace sogl {
+
+    // shadows the bindings of a GL context so that binding what is already bound costs nothing.
+    // every sogl class goes through it, raw GL calls that change the same state must be followed
+    // by invalidate()
+    class GlState {
+    public:
+        static constexpr unsigned max_texture_units = 32;
+
+        struct Stats {
+            std::size_t issued = 0;
+            std::size_t skipped = 0;
+        };
+
+        GlState();
+        ~GlState();
+
+        // state of the current context, each Window owns the state of its context
+        static auto current() -> GlState&;
+        void makeCurrent();
+
+        void useProgram(unsigned program);
+        // only used while no program is in use
+        void bindProgramPipeline(unsigned pipeline);
+        void bindVertexArray(unsigned vertex_array);
+        // the element array buffer binding is remembered per vertex array, as GL does
+        void bindBuffer(unsigned target, unsigned buffer);
+        // binds to an indexed binding point of the target, and to the target itself as GL does
+        void bindBufferBase(unsigned target, unsigned index, unsigned buffer);
+        // ranges are not shadowed, the next bindBufferBase of the binding point is always issued
+        void bindBufferRange(unsigned target, unsigned index, unsigned buffer, std::size_t offset, std::size_t size);
+        void bindTexture(unsigned texture, unsigned unit = 0);
+        void bindFramebuffer(unsigned framebuffer);
+
+        void setViewport(int x, int y, int width, int height);
+        void setEnabled(unsigned capability, bool enabled);
+        [[nodiscard]] auto isEnabled(unsigned capability) -> bool;
+        void setBlendFunc(unsigned source, unsigned destination);
+        void setDepthFunc(unsigned func);
+
+        // deletes the object and drops it from the bindings, its name may be reused by the driver
+        void deleteProgram(unsigned program);
+        void deleteProgramPipeline(unsigned pipeline);
+        void deleteVertexArray(unsigned vertex_array);
+        void deleteBuffer(unsigned buffer);
+        void deleteTexture(unsigned texture);
+        void deleteFramebuffer(unsigned framebuffer);
+
+        [[nodiscard]] auto getProgram() const -> unsigned;
+        [[nodiscard]] auto getProgramPipeline() const -> unsigned;
+
+        // forgets everything, the next calls are all issued
+        void invalidate();
+
+        [[nodiscard]] auto getStats() const -> const Stats&;
+        void resetStats();
+
+    private:
+        static constexpr unsigned unknown = ~0u;
+
+        auto changed(unsigned& cached, unsigned value) -> bool;
+        auto bufferSlot(unsigned target) -> unsigned*;
+
+        unsigned m_program = unknown;
+        unsigned m_program_pipeline = unknown;
+        unsigned m_vertex_array = unknown;
+        unsigned m_array_buffer = unknown;
+        unsigned m_copy_read_buffer = unknown;
+        unsigned m_copy_write_buffer = unknown;
+        unsigned m_draw_indirect_buffer = unknown;
+        unsigned m_uniform_buffer = unknown;
+        unsigned m_shader_storage_buffer = unknown;
+        unsigned m_pixel_unpack_buffer = unknown;
+        std::unordered_map<unsigned, unsigned> m_element_buffers;   // vertex array -> element buffer
+        std::unordered_map<std::uint64_t, unsigned> m_indexed_buffers;  // target << 32 | index -> buffer
+        unsigned m_active_texture = unknown;
+        std::array<unsigned, max_texture_units> m_textures;
+        unsigned m_framebuffer = unknown;
+        glm::ivec4 m_viewport = {-1, -1, -1, -1};
+        std::unordered_map<unsigned, bool> m_capabilities;
+        unsigned m_blend_source = unknown;
+        unsigned m_blend_destination = unknown;
+        unsigned m_depth_func = unknown;
+
+        Stats m_stats;
+    };
+
+}
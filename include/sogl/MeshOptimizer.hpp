@@ -0,0 +1,37 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace sogl {
+    // ACMR is the average number of vertex shader invocations per triangle, 0.5 is the best possible
+    struct MeshOptimizationReport {
+        std::size_t vertex_count_before = 0;
+        std::size_t vertex_count_after = 0;
+        float acmr_before = 0.f;
+        float acmr_after = 0.f;
+    };
+
+    namespace detail {
+        // vertices are packed with the given stride, indices form a triangle list
+
+        // merges vertices that are bitwise identical, returns the new vertex count
+        auto deduplicate_vertices(std::vector<std::byte>& vertices, std::size_t stride,
+                                  std::vector<unsigned>& indices) -> std::size_t;
+
+        // reorders the triangles for the post-transform cache (Tipsify)
+        void optimize_vertex_cache(std::vector<unsigned>& indices, std::size_t vertex_count, unsigned cache_size);
+
+        // reorders the vertices by first use and drops the unused ones, returns the new vertex count
+        auto optimize_vertex_fetch(std::vector<std::byte>& vertices, std::size_t stride,
+                                   std::vector<unsigned>& indices) -> std::size_t;
+
+        // simulates a FIFO post-transform cache
+        auto compute_acmr(const std::vector<unsigned>& indices, unsigned cache_size) -> float;
+
+        auto optimize_mesh(std::vector<std::byte>& vertices, std::size_t stride, std::vector<unsigned>& indices,
+                           unsigned cache_size) -> MeshOptimizationReport;
+    }
+}
@@ -0,0 +1,101 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#pragma once
+
+#include <sogl/Buffer.hpp>
+#include <sogl/GlState.hpp>
+#include <sogl/ShaderReflection.hpp>
+#include <sogl/Vertex.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace sogl {
+    namespace detail {
+        // layout expected by glMultiDrawElementsIndirect
+        struct DrawElementsIndirectCommand {
+            GLuint count;
+            GLuint instance_count;
+            GLuint first_index;
+            GLint base_vertex;
+            GLuint base_instance;
+        };
+    }
+
+    // many meshes sharing the same vertex layout, stored in a single VBO/IBO pair and
+    // drawn with one multi draw call
+    template <typename... AttrTypes>
+    class MeshPool {
+        using Layout = detail::VertexLayout<AttrTypes...>;
+
+    public:
+        using VertexTuple = std::tuple<AttrTypes...>;
+        using MeshId = std::uint32_t;
+
+        explicit MeshPool(Primitive primitive_type = Primitive::Triangles,
+                          std::size_t vertex_capacity = 1 << 16, std::size_t index_capacity = 1 << 18);
+        ~MeshPool();
+        MeshPool(const MeshPool&) = delete;
+        MeshPool(MeshPool&& other) noexcept;
+        auto operator=(const MeshPool&) -> MeshPool& = delete;
+        auto operator=(MeshPool&& other) noexcept -> MeshPool&;
+
+        // indices are relative to the first vertex of the mesh
+        template <typename VertexStruct>
+        auto add(std::span<const VertexStruct> vertices, std::span<const unsigned> indices) -> MeshId;
+        void remove(MeshId mesh);
+
+        void clearCommands();
+        void pushCommand(MeshId mesh, unsigned instance_count = 1);
+
+        [[nodiscard]] auto getMeshCount() const -> std::size_t;
+        [[nodiscard]] auto getCommandCount() const -> std::size_t;
+
+        void bind() const;
+        void render() const;
+
+    private:
+        static constexpr auto vertex_inputs = detail::vertex_input_descs<AttrTypes...>();
+
+        struct MeshRange {
+            std::size_t vertex_offset = 0;
+            std::size_t vertex_count = 0;
+            std::size_t index_offset = 0;
+            std::size_t index_count = 0;
+            bool alive = false;
+        };
+
+        void create();
+        // offset of the range in the buffer, it is attached to the vao again when the allocator grows
+        template <typename T>
+        auto allocate(BufferAllocator<T>& allocator, BufferTarget target, std::size_t count) -> std::size_t;
+
+        Primitive m_primitive_type;
+        GLuint m_vao = 0;
+
+        // vertices are allocated in bytes, every range is a multiple of the stride
+        BufferAllocator<std::byte> m_vertices;
+        BufferAllocator<unsigned> m_indices;
+        mutable Buffer<detail::DrawElementsIndirectCommand> m_indirect_buffer;
+        std::vector<MeshRange> m_meshes;
+        std::vector<MeshId> m_free_ids;
+        std::size_t m_mesh_count = 0;
+
+        std::vector<detail::DrawElementsIndirectCommand> m_commands;
+        mutable bool m_commands_dirty = false;
+
+        mutable std::vector<GLsizei> m_multi_counts;
+        mutable std::vector<const void*> m_multi_offsets;
+
+        std::vector<std::byte> m_vertex_scratch;
+        std::vector<unsigned> m_index_scratch;
+    };
+}
+
+#include <sogl/MeshPool.tpp>
@@ -0,0 +1,237 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#pragma once
+
+namespace sogl {
+
+    template <typename... AttrTypes>
+    MeshPool<AttrTypes...>::MeshPool(Primitive primitive_type, std::size_t vertex_capacity, std::size_t index_capacity) :
+    m_primitive_type(primitive_type),
+    m_vertices(vertex_capacity * Layout::stride, BufferUsage::StaticDraw),
+    m_indices(index_capacity, BufferUsage::StaticDraw) {
+        create();
+    }
+
+    template <typename... AttrTypes>
+    MeshPool<AttrTypes...>::~MeshPool() {
+        GlState::current().deleteVertexArray(m_vao);
+    }
+
+    template <typename... AttrTypes>
+    MeshPool<AttrTypes...>::MeshPool(MeshPool&& other) noexcept :
+    m_primitive_type(other.m_primitive_type),
+    m_vao(std::exchange(other.m_vao, 0)),
+    m_vertices(std::move(other.m_vertices)),
+    m_indices(std::move(other.m_indices)),
+    m_indirect_buffer(std::move(other.m_indirect_buffer)),
+    m_meshes(std::move(other.m_meshes)),
+    m_free_ids(std::move(other.m_free_ids)),
+    m_mesh_count(std::exchange(other.m_mesh_count, 0)),
+    m_commands(std::move(other.m_commands)),
+    m_commands_dirty(std::exchange(other.m_commands_dirty, false)),
+    m_multi_counts(std::move(other.m_multi_counts)),
+    m_multi_offsets(std::move(other.m_multi_offsets)),
+    m_vertex_scratch(std::move(other.m_vertex_scratch)),
+    m_index_scratch(std::move(other.m_index_scratch)) {}
+
+    template <typename... AttrTypes>
+    auto MeshPool<AttrTypes...>::operator=(MeshPool&& other) noexcept -> MeshPool& {
+        if (this != &other) {
+            GlState::current().deleteVertexArray(m_vao);
+            m_primitive_type = other.m_primitive_type;
+            m_vao = std::exchange(other.m_vao, 0);
+            m_vertices = std::move(other.m_vertices);
+            m_indices = std::move(other.m_indices);
+            m_indirect_buffer = std::move(other.m_indirect_buffer);
+            m_meshes = std::move(other.m_meshes);
+            m_free_ids = std::move(other.m_free_ids);
+            m_mesh_count = std::exchange(other.m_mesh_count, 0);
+            m_commands = std::move(other.m_commands);
+            m_commands_dirty = std::exchange(other.m_commands_dirty, false);
+            m_multi_counts = std::move(other.m_multi_counts);
+            m_multi_offsets = std::move(other.m_multi_offsets);
+            m_vertex_scratch = std::move(other.m_vertex_scratch);
+            m_index_scratch = std::move(other.m_index_scratch);
+        }
+        return *this;
+    }
+
+    template <typename... AttrTypes>
+    void MeshPool<AttrTypes...>::create() {
+        glGenVertexArrays(1, &m_vao);
+        GlState::current().bindVertexArray(m_vao);
+
+        m_vertices.getBuffer().bind(BufferTarget::Vertex);
+        detail::enable_vertex_attribs<Layout, 0, AttrTypes...>();
+
+        m_indices.getBuffer().bind(BufferTarget::Index);
+    }
+
+    template <typename... AttrTypes>
+    template <typename T>
+    auto MeshPool<AttrTypes...>::allocate(BufferAllocator<T>& allocator, BufferTarget target, std::size_t count) -> std::size_t {
+        const auto buffer = allocator.getBuffer().getId();
+        const auto range = allocator.allocate(count);
+        if (allocator.getBuffer().getId() != buffer) {
+            // the meshes were copied to a bigger buffer
+            GlState::current().bindVertexArray(m_vao);
+            allocator.getBuffer().bind(target);
+            if (target == BufferTarget::Vertex) {
+                detail::enable_vertex_attribs<Layout, 0, AttrTypes...>();
+            }
+        }
+        return range.first;
+    }
+
+    template <typename... AttrTypes>
+    template <typename VertexStruct>
+    auto MeshPool<AttrTypes...>::add(std::span<const VertexStruct> vertices, std::span<const unsigned> indices) -> MeshId {
+        MeshRange range;
+        range.vertex_count = vertices.size();
+        range.index_count = indices.size();
+        range.vertex_offset = allocate(m_vertices, BufferTarget::Vertex, range.vertex_count * Layout::stride) / Layout::stride;
+        range.index_offset = allocate(m_indices, BufferTarget::Index, range.index_count);
+        range.alive = true;
+
+        if constexpr (detail::packed_vertex<VertexStruct, AttrTypes...>) {
+            m_vertices.getBuffer().update(std::as_bytes(vertices), range.vertex_offset * Layout::stride);
+        } else {
+            m_vertex_scratch.resize(range.vertex_count * Layout::stride);
+            Layout::storeRange(m_vertex_scratch.data(), vertices);
+            m_vertices.getBuffer().update(m_vertex_scratch, range.vertex_offset * Layout::stride);
+        }
+
+        // indices are stored relative to the start of the pool, so draws don't need a base vertex
+        m_index_scratch.resize(range.index_count);
+        for (std::size_t i = 0; i < range.index_count; ++i) {
+            m_index_scratch[i] = indices[i] + static_cast<unsigned>(range.vertex_offset);
+        }
+        m_indices.getBuffer().update(m_index_scratch, range.index_offset);
+
+        MeshId id;
+        if (!m_free_ids.empty()) {
+            id = m_free_ids.back();
+            m_free_ids.pop_back();
+            m_meshes[id] = range;
+        } else {
+            id = static_cast<MeshId>(m_meshes.size());
+            m_meshes.push_back(range);
+        }
+        ++m_mesh_count;
+        return id;
+    }
+
+    template <typename... AttrTypes>
+    void MeshPool<AttrTypes...>::remove(MeshId mesh) {
+        if (mesh >= m_meshes.size() || !m_meshes[mesh].alive)
+            return;
+
+        auto& range = m_meshes[mesh];
+        m_vertices.free({range.vertex_offset * Layout::stride, range.vertex_count * Layout::stride});
+        m_indices.free({range.index_offset, range.index_count});
+        range.alive = false;
+        m_free_ids.push_back(mesh);
+        --m_mesh_count;
+
+        // the freed ranges may be reused by the next mesh, forget the commands drawing this one
+        const auto erased = std::erase_if(m_commands, [&](const auto& command) {
+            return command.first_index == range.index_offset && command.count == range.index_count;
+        });
+        m_commands_dirty |= erased > 0;
+    }
+
+    template <typename... AttrTypes>
+    void MeshPool<AttrTypes...>::clearCommands() {
+        m_commands.clear();
+        m_commands_dirty = true;
+    }
+
+    template <typename... AttrTypes>
+    void MeshPool<AttrTypes...>::pushCommand(MeshId mesh, unsigned instance_count) {
+        if (mesh >= m_meshes.size() || !m_meshes[mesh].alive)
+            return;
+
+        const auto& range = m_meshes[mesh];
+        m_commands.push_back({
+            static_cast<GLuint>(range.index_count),
+            instance_count,
+            static_cast<GLuint>(range.index_offset),
+            0,
+            0
+        });
+        m_commands_dirty = true;
+    }
+
+    template <typename... AttrTypes>
+    auto MeshPool<AttrTypes...>::getMeshCount() const -> std::size_t {
+        return m_mesh_count;
+    }
+
+    template <typename... AttrTypes>
+    auto MeshPool<AttrTypes...>::getCommandCount() const -> std::size_t {
+        return m_commands.size();
+    }
+
+    template <typename... AttrTypes>
+    void MeshPool<AttrTypes...>::bind() const {
+        GlState::current().bindVertexArray(m_vao);
+#if !defined(EMSCRIPTEN)
+        if (GLEW_ARB_multi_draw_indirect) {
+            if (m_commands_dirty) {
+                if (m_commands.size() > m_indirect_buffer.getSize()) {
+                    m_indirect_buffer.create(std::max(m_commands.size(), m_indirect_buffer.getSize() * 2));
+                }
+                m_indirect_buffer.update(m_commands);
+                m_commands_dirty = false;
+            }
+            m_indirect_buffer.bind(BufferTarget::DrawIndirect);
+        }
+#endif
+    }
+
+    template <typename... AttrTypes>
+    void MeshPool<AttrTypes...>::render() const {
+        if (m_commands.empty())
+            return;
+
+#if !defined(NDEBUG)
+        const auto program = GlState::current().getProgram();
+        detail::check_vertex_inputs(program, vertex_inputs);
+        if (program == 0) {
+            detail::check_program_pipeline(GlState::current().getProgramPipeline());
+        }
+#endif
+        const auto mode = static_cast<std::underlying_type_t<Primitive>>(m_primitive_type);
+#if !defined(EMSCRIPTEN)
+        if (GLEW_ARB_multi_draw_indirect) {
+            glMultiDrawElementsIndirect(mode, GL_UNSIGNED_INT, nullptr, static_cast<GLsizei>(m_commands.size()), 0);
+            return;
+        }
+#endif
+        // no indirect draws, runs of single instance commands are merged in one glMultiDrawElements
+        std::size_t i = 0;
+        while (i < m_commands.size()) {
+            const auto& command = m_commands[i];
+            const auto* offset = reinterpret_cast<void*>(command.first_index * sizeof(unsigned));
+            if (command.instance_count != 1) {
+                glDrawElementsInstanced(mode, static_cast<GLsizei>(command.count), GL_UNSIGNED_INT, offset, command.instance_count);
+                ++i;
+                continue;
+            }
+#if !defined(EMSCRIPTEN)
+            m_multi_counts.clear();
+            m_multi_offsets.clear();
+            for (; i < m_commands.size() && m_commands[i].instance_count == 1; ++i) {
+                m_multi_counts.push_back(static_cast<GLsizei>(m_commands[i].count));
+                m_multi_offsets.push_back(reinterpret_cast<void*>(m_commands[i].first_index * sizeof(unsigned)));
+            }
+            glMultiDrawElements(mode, m_multi_counts.data(), GL_UNSIGNED_INT, m_multi_offsets.data(),
+                                static_cast<GLsizei>(m_multi_counts.size()));
+#else
+            glDrawElements(mode, static_cast<GLsizei>(command.count), GL_UNSIGNED_INT, offset);
+            ++i;
+#endif
+        }
+    }
+
+}
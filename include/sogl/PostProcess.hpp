@@ -2,8 +2,9 @@
 
 #pragma once
 
-#include <sogl/Shader.hpp>
+#include <sogl/ShaderPipeline.hpp>
 
+#include <memory>
 #include <string>
 
 namespace sogl {
@@ -20,7 +21,10 @@ namespace sogl {
         PostProcess() = default;
         void set(const std::string& post_process_shader_src);
 
-        Shader shader;
+        // the quad vertex stage is shared by all the post processes. the fragment stage stays at the
+        // same address when the post process is moved, the pipeline points to it
+        std::unique_ptr<ShaderStage> fragment_stage = std::make_unique<ShaderStage>();
+        ShaderPipeline pipeline;
     };
 
 } // namespace sogl
@@ -0,0 +1,71 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#pragma once
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/gtc/type_precision.hpp>
+
+#include <cstddef>
+#include <span>
+
+namespace sogl {
+
+    // GLSL decoding of the normals produced by Quantizer::normal, to paste in the vertex shader
+    constexpr auto OCT_NORMAL_DECODE_SRC = R"(
+        vec3 octDecode(vec2 e) {
+            vec3 v = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+            if (v.z < 0.0)
+                v.xy = (1.0 - abs(v.yx)) * vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+            return normalize(v);
+        }
+    )";
+
+    struct QuantizationError {
+        float max = 0.f;
+        float mean = 0.f;
+        std::size_t count = 0;
+    };
+
+    // errors are a distance for positions and uvs, and an angle in radians for normals
+    struct QuantizationReport {
+        QuantizationError position;
+        QuantizationError normal;
+        QuantizationError uv;
+    };
+
+    // converts float attributes to smaller normalized integers, while measuring the precision loss.
+    // positions are stored relative to the bounding box of the mesh, the shader gets them back in
+    // model space by multiplying them with the dequantization matrix (see VertexArray::setDequantization)
+    class Quantizer {
+    public:
+        explicit Quantizer(std::span<const glm::vec3> positions);
+
+        // read as a vec4 with w = 1 by the shader
+        auto position(const glm::vec3& p) -> glm::u16vec4;
+        // octahedral encoding, read as a vec2 and decoded with OCT_NORMAL_DECODE_SRC
+        auto normal(const glm::vec3& n) -> glm::i16vec2;
+        // uvs inside a [0, 1] atlas tile
+        auto uv(const glm::vec2& t) -> glm::u8vec2;
+
+        [[nodiscard]] auto getDequantization() const -> glm::mat4;
+        [[nodiscard]] auto getReport() const -> QuantizationReport;
+
+    private:
+        struct ErrorAccumulator {
+            void add(float error);
+            [[nodiscard]] auto get() const -> QuantizationError;
+
+            float max = 0.f;
+            double sum = 0.;
+            std::size_t count = 0;
+        };
+
+        glm::vec3 m_min;
+        glm::vec3 m_extent;
+        ErrorAccumulator m_position_error;
+        ErrorAccumulator m_normal_error;
+        ErrorAccumulator m_uv_error;
+    };
+}
@@ -0,0 +1,87 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#pragma once
+
+#include <sogl/Shader.hpp>
+#include <sogl/Texture.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace sogl {
+    namespace detail {
+        // stable LSD radix sort on the keys, 8 bits per pass, passes where all keys share the digit are skipped
+        void radix_sort(std::vector<std::pair<std::uint64_t, std::uint32_t>>& items,
+                        std::vector<std::pair<std::uint64_t, std::uint32_t>>& scratch);
+    }
+
+    // collects draws in any order, then runs them sorted by a 64-bit key so that redundant
+    // shader, texture and mesh binds are skipped.
+    // key layout, from the most significant bits : layer (8), shader (12), texture (12), depth (16), mesh (16).
+    // a single execution holds at most 4096 shaders and textures and 65536 meshes
+    class RenderQueue {
+    public:
+        using UniformSetter = void (*)(const Shader& shader, const void* user_data);
+
+        struct DrawParams {
+            const Texture* texture = nullptr;
+            std::uint8_t layer = 0;
+            float depth = 0.f;                      // in [0, 1], lower depths are drawn first
+            UniformSetter uniforms = nullptr;       // called before the draw, once the shader is bound
+            const void* user_data = nullptr;
+        };
+
+        struct Stats {
+            std::size_t draws = 0;
+            std::size_t state_changes_unsorted = 0;  // binds needed in submission order
+            std::size_t state_changes = 0;           // binds issued after sorting
+        };
+
+        // mesh is anything with bind() and render(), like a VertexArray. it must outlive the execution
+        template <typename Mesh> requires requires(const Mesh& mesh) { mesh.bind(); mesh.render(); }
+        void submit(const Mesh& mesh, const Shader& shader, const DrawParams& params = {}) {
+            push({
+                &shader,
+                params.texture,
+                &mesh,
+                [](const void* m) { static_cast<const Mesh*>(m)->bind(); },
+                [](const void* m) { static_cast<const Mesh*>(m)->render(); },
+                params.uniforms,
+                params.user_data
+            }, params.layer, params.depth);
+        }
+
+        void clear();
+        // sorts and runs the draws, then clears the queue
+        void execute();
+
+        [[nodiscard]] auto getStats() const -> const Stats&;
+
+    private:
+        struct Command {
+            const Shader* shader;
+            const Texture* texture;
+            const void* mesh;
+            void (*bind_mesh)(const void*);
+            void (*render_mesh)(const void*);
+            UniformSetter uniforms;
+            const void* user_data;
+        };
+
+        void push(const Command& command, std::uint8_t layer, float depth);
+        auto idOf(std::unordered_map<const void*, std::uint32_t>& ids, const void* object, std::uint32_t max_id) -> std::uint64_t;
+        auto countStateChanges(bool sorted) const -> std::size_t;
+
+        std::vector<Command> m_commands;
+        std::vector<std::pair<std::uint64_t, std::uint32_t>> m_keys;
+        std::vector<std::pair<std::uint64_t, std::uint32_t>> m_scratch;
+        std::unordered_map<const void*, std::uint32_t> m_shader_ids;
+        std::unordered_map<const void*, std::uint32_t> m_texture_ids;
+        std::unordered_map<const void*, std::uint32_t> m_mesh_ids;
+        Stats m_stats;
+    };
+
+}
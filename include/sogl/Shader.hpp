@@ -3,13 +3,25 @@
 #pragma once
 
 #include <sogl/GlObject.hpp>
+#include <sogl/ShaderReflection.hpp>
 
 #include <GL/glew.h>
 #include <glm/glm.hpp>
 
+#include <array>
+#include <cassert>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #if defined(EMSCRIPTEN)
 #define GLSL(version, src) "#version 300 es\n" #src
@@ -19,12 +31,63 @@
 
 namespace sogl {
 
+#if !defined(EMSCRIPTEN)
+    // writes of compute shaders made visible to the later reads of the given kind
+    enum class Barrier : unsigned {
+        VertexAttribArray = GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT,
+        ElementArray = GL_ELEMENT_ARRAY_BARRIER_BIT,
+        Uniform = GL_UNIFORM_BARRIER_BIT,
+        TextureFetch = GL_TEXTURE_FETCH_BARRIER_BIT,
+        ShaderImageAccess = GL_SHADER_IMAGE_ACCESS_BARRIER_BIT,
+        Command = GL_COMMAND_BARRIER_BIT,
+        TextureUpdate = GL_TEXTURE_UPDATE_BARRIER_BIT,
+        BufferUpdate = GL_BUFFER_UPDATE_BARRIER_BIT,
+        Framebuffer = GL_FRAMEBUFFER_BARRIER_BIT,
+        ShaderStorage = GL_SHADER_STORAGE_BARRIER_BIT,
+        All = GL_ALL_BARRIER_BITS,
+    };
+
+    auto operator|(const Barrier& left, const Barrier& right) -> Barrier;
+#endif
+
+    class Shader;
+    class ShaderBatch;
+    class ShaderLibrary;
+    class ShaderPipeline;
+    class ShaderStage;
+
+    // uniform of a shader resolved once, setting it skips the name lookup.
+    // a handle is only meaningful for the shader that returned it
+    template <typename T>
+    class Uniform {
+    public:
+        Uniform() = default;
+
+    private:
+        friend class Shader;
+        explicit Uniform(unsigned slot) : m_slot(slot) {}
+
+        unsigned m_slot = ~0u;
+    };
+
     class Shader {
     public:
+        // uniform values equal to the ones already set are not sent again
+        struct UniformStats {
+            std::size_t hits = 0;       // skipped calls
+            std::size_t misses = 0;     // issued calls
+        };
+
         enum class Type : int {
             Vertex,
             Geometry,
             Fragment,
+            Compute,        // needs GL 4.3 or GL_ARB_compute_shader
+        };
+
+        struct Source {
+            Type type;
+            std::string_view code;
         };
 
     private:
@@ -46,11 +109,25 @@ namespace sogl {
             void destroy();
             void attachShader(const ShaderObject& shader_handle);
             void detachShader(const ShaderObject& shader_handle);
+            void attachShader(unsigned shader_handle);
+            void detachShader(unsigned shader_handle);
+            void setBinaryRetrievable() const;
+            void setSeparable() const;
+            void useStages(unsigned pipeline, unsigned stages) const;
+            auto getBinary(unsigned& format) const -> std::vector<char>;
+            // returns the link status, the driver rejects binaries of another GPU or driver version
+            auto loadBinary(unsigned format, const std::vector<char>& binary) const -> bool;
             void link() const;
             void validate() const;
             auto getInfoLog() const -> std::string;
             void use() const;
+            auto getId() const -> unsigned;
             auto getUniformLocation(const std::string& uniform) const -> int;
+            void bindUniformBlocks() const;
+            void bindStorageBlocks() const;
+            // builds the reflection table and gives each sampler its own texture unit
+            void reflect() const;
+            auto getReflection() const -> const ShaderReflection*;
             auto getStatus(unsigned status_type) const -> int;
             operator bool();
         };
@@ -59,13 +136,14 @@ namespace sogl {
         Shader() = default;
         ~Shader();
         Shader(const Shader&) = delete;
-        Shader(Shader&&) = default;
+        Shader(Shader&& other) noexcept;
         Shader& operator=(const Shader&) = delete;
-        Shader& operator=(Shader&&) = default;
+        Shader& operator=(Shader&& other) noexcept;
 
         static auto compileVertex(const std::string& src) -> CompiledShaderObject<Type::Vertex>;
         static auto compileGeometry(const std::string& src) -> CompiledShaderObject<Type::Geometry>;
         static auto compileFragment(const std::string& src) -> CompiledShaderObject<Type::Fragment>;
+        static auto compileCompute(const std::string& src) -> CompiledShaderObject<Type::Compute>;
 
         template <typename... TShaderObjects>
         auto load(TShaderObjects&... shader_objects) -> bool {
@@ -76,18 +154,57 @@ namespace sogl {
             return ret;
         }
 
+        // compiles and links the sources, or restores the program from the binary cache when it is enabled.
+        // each define is inserted as "#define <define>" after the #version line of every source
+        auto loadSources(const std::vector<Source>& sources, const std::vector<std::string>& defines = {}) -> bool;
+
+        // linked programs are saved in the directory and restored by loadSources on the next runs.
+        // an empty path disables the cache, it is disabled by default
+        static void setBinaryCacheDirectory(const std::filesystem::path& directory);
+
+        // false while a ShaderBatch is still compiling the program
+        [[nodiscard]] auto isReady() const -> bool;
+
         void bind() const;
 
+#if !defined(EMSCRIPTEN)
+        // binds the compute program and runs it on a grid of work groups
+        void dispatch(unsigned groups_x, unsigned groups_y = 1, unsigned groups_z = 1) const;
+
+        static void memoryBarrier(Barrier barriers);
+#endif
+
         [[nodiscard]]
-        auto getUniformLocation(const std::string& uniform) const -> int;
+        auto getUniformLocation(std::string_view uniform) const -> int;
+
+        [[nodiscard]] auto getReflection() const -> const ShaderReflection&;
+
+        // samplers keep an explicit layout(binding = N) other than 0, the others get consecutive free texture units
+        // in the order of their names. -1 if there is no such sampler
+        [[nodiscard]] auto getSamplerUnit(std::string_view sampler) const -> int;
+
+        template <typename T>
+        [[nodiscard]] auto getUniform(std::string_view uniform) const -> Uniform<T>;
+
+        template <typename T>
+        void setUniform(std::string_view uniform, const T& val) const;
 
         template <typename T>
-        void setUniform(const std::string& uniform, const T& val) const;
+        void setUniform(const Uniform<T>& uniform, const std::type_identity_t<T>& val) const;
 
+        // arrays are always sent, only single values are shadowed
         template <typename T>
-        void setUniform(const std::string& uniform, const std::initializer_list<T>& arr) const;
+        void setUniform(std::string_view uniform, const std::initializer_list<T>& arr) const;
+
+        [[nodiscard]] auto getUniformStats() const -> const UniformStats&;
+        void resetUniformStats();
 
     private:
+        friend class ShaderBatch;
+        friend class ShaderLibrary;
+        friend class ShaderPipeline;
+        friend class ShaderStage;
+
         template <typename TShaderObject, typename... TShaderObjects> requires std::derived_from<TShaderObject, ShaderObject>
         void attach_r(TShaderObject& shader_object, TShaderObjects&... shader_objects) {
             attach(shader_object);
@@ -109,9 +226,56 @@ namespace sogl {
         void attach(const ShaderObject& handle);
         void detach(const ShaderObject& handle);
         auto linkAndValidate() -> bool;
+        auto checkLink() -> bool;
+        void onLinked();
+
+        // loadSources in two steps, compile and link are issued without waiting for the driver
+        void submitSources(const std::vector<Source>& sources, const std::vector<std::string>& defines);
+        static auto hasParallelCompile() -> bool;
+        auto isLinkDone() const -> bool;
+        auto finishSources() -> bool;
+        auto loadBinary(const std::filesystem::path& file) -> bool;
+        void saveBinary(const std::filesystem::path& file) const;
+        // deletes the program and the pending compile, leaving the batch that was compiling it
+        void destroy();
+
+        struct UniformSlot {
+            int location = -1;
+            std::uint8_t size = 0;      // size of the shadowed value, 0 until the uniform is set
+            std::array<std::byte, sizeof(glm::mat4)> value = {};
+        };
+
+        // index of the uniform in m_uniforms, looked up in the reflection table the first time
+        auto getUniformSlot(std::string_view uniform) const -> unsigned;
+        auto findUniformLocation(std::string_view uniform) const -> int;
+
+        template <typename T>
+        void setUniformSlot(unsigned slot, const T& val) const;
+
+        // glUniform calls go to the program in use, this one is used for the upload when it is not
+        auto beginUpload() const -> unsigned;
+        void endUpload(unsigned previous) const;
+
+        template <typename T>
+        static void uploadUniform(int location, const T& val);
+
+        struct StringHash {
+            using is_transparent = void;
+            auto operator()(std::string_view str) const -> std::size_t { return std::hash<std::string_view>()(str); }
+        };
+
+        struct PendingLink {
+            std::vector<std::pair<Type, unsigned>> objects;
+            std::filesystem::path cache_file;
+        };
 
         Program m_program;
-        mutable std::unordered_map<std::string, int> m_uniforms_location;
+        std::optional<PendingLink> m_pending;
+        bool m_separable = false;
+        mutable std::unordered_map<std::string, unsigned, StringHash, std::equal_to<>> m_uniform_slots;
+        mutable std::vector<UniformSlot> m_uniforms;
+        mutable UniformStats m_uniform_stats;
+        ShaderBatch* m_batch = nullptr;     // set while a batch holds the shader as pending
     };
 
 #include "Shader.tpp"
@@ -1,8 +1,45 @@
 // Created by Modar Nasser on 28/02/2022.
 
 template <typename T>
-void Shader::setUniform(const std::string& uniform, const T& val) const {
-    auto location = getUniformLocation(uniform);
+auto Shader::getUniform(std::string_view uniform) const -> Uniform<T> {
+    return Uniform<T>(getUniformSlot(uniform));
+}
+
+template <typename T>
+void Shader::setUniform(std::string_view uniform, const T& val) const {
+    setUniformSlot(getUniformSlot(uniform), val);
+}
+
+template <typename T>
+void Shader::setUniform(const Uniform<T>& uniform, const std::type_identity_t<T>& val) const {
+    // a default handle sets nothing, like a uniform that is not in the program
+    if (uniform.m_slot >= m_uniforms.size())
+        return;
+    setUniformSlot(uniform.m_slot, val);
+}
+
+template <typename T>
+void Shader::setUniformSlot(unsigned slot, const T& val) const {
+    static_assert(sizeof(T) <= sizeof(UniformSlot::value) && std::is_trivially_copyable_v<T>);
+    auto& uniform = m_uniforms[slot];
+    if (uniform.location < 0)
+        return;
+
+    // values are compared bitwise, the program keeps them until it is linked again
+    if (uniform.size == sizeof(T) && std::memcmp(uniform.value.data(), &val, sizeof(T)) == 0) {
+        ++m_uniform_stats.hits;
+        return;
+    }
+    std::memcpy(uniform.value.data(), &val, sizeof(T));
+    uniform.size = sizeof(T);
+    ++m_uniform_stats.misses;
+    const auto previous = beginUpload();
+    uploadUniform(uniform.location, val);
+    endUpload(previous);
+}
+
+template <typename T>
+void Shader::uploadUniform(int location, const T& val) {
     if constexpr(std::is_same_v<T, float>) {
         glUniform1f(location, val);
     } else if constexpr(std::is_same_v<T, int>) {
@@ -55,8 +92,11 @@ void Shader::setUniform(const std::string& uniform, const T& val) const {
 }
 
 template <typename T>
-void Shader::setUniform(const std::string& uniform, const std::initializer_list<T>& arr) const {
-    auto location = getUniformLocation(uniform);
+void Shader::setUniform(std::string_view uniform, const std::initializer_list<T>& arr) const {
+    auto& slot = m_uniforms[getUniformSlot(uniform)];
+    slot.size = 0;
+    auto location = slot.location;
+    const auto previous = beginUpload();
     if constexpr(std::is_same_v<T, float>) {
         glUniform1fv(location, std::size(arr), std::data(arr));
     } else if constexpr(std::is_same_v<T, int>) {
@@ -106,4 +146,5 @@ void Shader::setUniform(const std::string& uniform, const std::initializer_list<
     } else if constexpr(std::is_same_v<T, glm::mat4x4>) {
         glUniformMatrix4fv(location, std::size(arr), false, reinterpret_cast<const float*>(std::data(arr)));
     }
+    endUpload(previous);
 }
@@ -0,0 +1,55 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#pragma once
+
+#include <sogl/Shader.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace sogl {
+
+    // loads many shaders without waiting for each of them to compile. with GL_KHR_parallel_shader_compile
+    // or GL_ARB_parallel_shader_compile, poll() never blocks and the driver compiles on its own threads.
+    // without them, poll() finishes one shader per call so that a loading screen keeps rendering
+    class ShaderBatch {
+    public:
+        struct Stats {
+            std::size_t total = 0;
+            std::size_t done = 0;
+            std::size_t failed = 0;     // done, but failed to compile or link
+        };
+
+        ShaderBatch() = default;
+        ~ShaderBatch();
+        ShaderBatch(const ShaderBatch&) = delete;
+        ShaderBatch& operator=(const ShaderBatch&) = delete;
+
+        // compile and link are issued right away. a shader finished or destroyed before the batch
+        // is done leaves it, a destroyed one is no longer counted in the stats
+        void add(Shader& shader, const std::vector<Shader::Source>& sources, const std::vector<std::string>& defines = {});
+
+        // checks the shaders that finished, returns true once all of them are ready
+        auto poll() -> bool;
+        // blocks until every shader is ready
+        void wait();
+
+        [[nodiscard]] auto isDone() const -> bool;
+        [[nodiscard]] auto getStats() const -> const Stats&;
+
+    private:
+        friend class Shader;
+        friend class ShaderLibrary;
+
+        void finish(Shader& shader);
+        // finishes a pending shader out of order, for a shader needed right away
+        void finishNow(Shader& shader);
+        void drop(Shader& shader);
+        void replace(const Shader& from, Shader& to);
+
+        std::vector<Shader*> m_pending;
+        Stats m_stats;
+    };
+
+}
@@ -0,0 +1,65 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#pragma once
+
+#include <sogl/Shader.hpp>
+#include <sogl/ShaderBatch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace sogl {
+
+    // named GLSL sources that can #include each other, and programs built from them with
+    // permutations of defines. a variant is only compiled the first time it is requested
+    class ShaderLibrary {
+    public:
+        using ProgramId = unsigned;
+        using Variant = std::uint64_t;      // bitmask of the defines added to the library
+
+        // the source can be included by others with #include "name", included sources have no #version line
+        void addSource(std::string name, std::string code);
+        auto loadSource(std::string name, const std::filesystem::path& file) -> bool;
+
+        // returns the bit of the define in variants, such as "HAS_NORMAL_MAP" or "LIGHT_COUNT 4"
+        auto addDefine(std::string define) -> Variant;
+
+        // a program made of the named sources, one per stage
+        auto addProgram(std::vector<std::pair<Shader::Type, std::string>> stages) -> ProgramId;
+
+        // compiles the variant on first use, a variant failing to compile is returned unusable
+        auto get(ProgramId program, Variant variant = 0) -> Shader&;
+
+        // compiles the variants up front, waiting for them or through the batch
+        void prewarm(ProgramId program, std::span<const Variant> variants);
+        void prewarm(ProgramId program, std::span<const Variant> variants, ShaderBatch& batch);
+
+        // destroys a compiled variant, it is compiled again on its next use
+        void release(ProgramId program, Variant variant);
+        [[nodiscard]] auto getVariantCount() const -> std::size_t;
+
+        // the code with its #include lines replaced by the named sources, each source is included once
+        [[nodiscard]] auto preprocess(std::string_view code) const -> std::string;
+
+    private:
+        struct Program {
+            std::vector<std::pair<Shader::Type, std::string>> stages;
+            std::unordered_map<Variant, Shader> variants;
+        };
+
+        void expand(std::string_view code, std::string& result, std::vector<std::string_view>& included) const;
+        void submit(const Program& program, Variant variant, Shader& shader, ShaderBatch* batch) const;
+
+        std::unordered_map<std::string, std::string> m_sources;
+        std::vector<std::string> m_defines;
+        std::vector<Program> m_programs;
+    };
+
+}
@@ -0,0 +1,87 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#pragma once
+
+#include <sogl/Shader.hpp>
+
+#include <concepts>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sogl {
+
+    // a single stage linked on its own, shared by any number of ShaderPipelines.
+    // without separate shader objects it only keeps its sources for the pipelines to link
+    class ShaderStage {
+    public:
+        auto load(Shader::Type type, std::vector<std::string> sources) -> bool;
+
+        [[nodiscard]] auto getType() const -> Shader::Type;
+
+    private:
+        friend class ShaderPipeline;
+
+        Shader::Type m_type = Shader::Type::Vertex;
+        std::vector<std::string> m_sources;
+        Shader m_shader;
+        // load of the pipeline whose sampler units are set in the program, 0 for its own units
+        mutable std::uint64_t m_sampler_units_of = 0;
+    };
+
+    // stages combined at draw time with GL_ARB_separate_shader_objects, N vertex and M fragment
+    // stages need N + M links instead of N * M. falls back to linking the sources of the stages
+    // in one program when separate shader objects are not supported
+    class ShaderPipeline {
+    public:
+        ShaderPipeline() = default;
+        ~ShaderPipeline();
+        ShaderPipeline(const ShaderPipeline&) = delete;
+        ShaderPipeline(ShaderPipeline&& other) noexcept;
+        ShaderPipeline& operator=(const ShaderPipeline&) = delete;
+        ShaderPipeline& operator=(ShaderPipeline&& other) noexcept;
+
+        [[nodiscard]] static auto isSupported() -> bool;
+
+        // the stages must outlive the pipeline. texture units are given to the samplers of all the
+        // stages together, a sampler declared with the same name in several stages gets a single unit
+        template <typename... TStages> requires (std::same_as<TStages, ShaderStage> && ...)
+        auto load(const TStages&... stages) -> bool {
+            return loadStages({&stages...});
+        }
+
+        void bind() const;
+
+        // -1 if no stage uses the sampler
+        [[nodiscard]] auto getSamplerUnit(std::string_view sampler) const -> int;
+
+        // set in every stage using the uniform
+        template <typename T>
+        void setUniform(std::string_view uniform, const T& val) const;
+
+    private:
+        struct Sampler {
+            std::string name;
+            const ShaderStage* stage;
+            int location;
+            int size;
+            int unit;
+        };
+
+        auto loadStages(std::vector<const ShaderStage*> stages) -> bool;
+        // stages are linked on their own, each one gives units starting from 0
+        void assignSamplerUnits();
+        // the stages may be shared with other pipelines that set their own units
+        void uploadSamplerUnits() const;
+
+        unsigned m_pipeline = 0;
+        std::uint64_t m_load_id = 0;
+        std::vector<const ShaderStage*> m_stages;
+        std::vector<Sampler> m_samplers;
+        Shader m_monolithic;
+    };
+
+#include "ShaderPipeline.tpp"
+
+}
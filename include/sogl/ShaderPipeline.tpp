@@ -0,0 +1,15 @@
+// Created by Modar Nasser on 17/10/2026.
+
+template <typename T>
+void ShaderPipeline::setUniform(std::string_view uniform, const T& val) const {
+    if (m_pipeline == 0) {
+        m_monolithic.setUniform(uniform, val);
+        return;
+    }
+    for (const auto* stage : m_stages) {
+        const auto& shader = stage->m_shader;
+        if (shader.getUniformLocation(uniform) >= 0) {
+            shader.setUniform(uniform, val);
+        }
+    }
+}
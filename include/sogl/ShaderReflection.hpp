@@ -0,0 +1,67 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#pragma once
+
+#include <sogl/Vertex.hpp>
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sogl {
+
+    // interface of a linked program, read once after linking. each table is sorted by name,
+    // arrays are listed once under their name without the [0] suffix
+    struct ShaderReflection {
+        struct Uniform {
+            std::string name;
+            unsigned type;
+            int size;               // number of elements of arrays, 1 otherwise
+            int location;
+            int unit = -1;          // first texture unit of samplers
+            bool explicit_unit = false; // given by layout(binding = N)
+        };
+
+        struct Block {
+            std::string name;
+            unsigned binding;
+        };
+
+        struct Input {
+            std::string name;
+            unsigned type;
+            int size;
+            int location;
+        };
+
+        std::vector<Uniform> uniforms;      // uniforms of the default block only
+        std::vector<Block> blocks;
+        std::vector<Input> inputs;
+
+        [[nodiscard]] auto findUniform(std::string_view name) const -> const Uniform*;
+        [[nodiscard]] auto findBlock(std::string_view name) const -> const Block*;
+        [[nodiscard]] auto findInput(std::string_view name) const -> const Input*;
+
+        static auto reflect(unsigned program) -> ShaderReflection;
+        static auto isSampler(unsigned type) -> bool;
+    };
+
+    namespace detail {
+        // reflections of the programs created by Shader, for code that only knows the program in use
+        auto find_reflection(unsigned program) -> const ShaderReflection*;
+        void set_reflection(unsigned program, ShaderReflection reflection);
+        void drop_reflection(unsigned program);
+
+        // -1 when the program has no such uniform
+        auto uniform_location(unsigned program, std::string_view uniform) -> int;
+
+        // warns when an input of the program is not fed by the vertex array, or is fed integers
+        // while reading floats or the other way around. each program and layout pair is checked once
+        void check_vertex_inputs(unsigned program, std::span<const VertexInputDesc> attribs);
+
+        // validates the program pipeline against the current state, the log of a pipeline is printed once
+        void check_program_pipeline(unsigned pipeline);
+    }
+
+}
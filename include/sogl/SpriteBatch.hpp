@@ -0,0 +1,83 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#pragma once
+
+#include <sogl/Shader.hpp>
+#include <sogl/Texture.hpp>
+#include <sogl/VertexArray.hpp>
+
+#include <glm/mat3x3.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+#include <glm/gtc/type_precision.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace sogl {
+
+    struct Sprite {
+        const Texture* texture = nullptr;           // plain color when null
+        const Shader* shader = nullptr;             // SpriteBatch default shader when null
+        glm::vec4 rect = {0.f, 0.f, 1.f, 1.f};      // x, y, width, height
+        glm::vec4 uv = {0.f, 0.f, 1.f, 1.f};        // left, top, right, bottom
+        glm::vec4 color = {1.f, 1.f, 1.f, 1.f};
+        glm::mat3 transform = glm::mat3(1.f);       // 2D affine transform applied to the rect
+        int layer = 0;                              // lower layers are drawn first, in [-32768, 32767]
+    };
+
+    // collects the sprites of a frame and draws them with as few draw calls as possible.
+    // sprites are sorted by layer, shader and texture, the submission order is kept otherwise.
+    // custom shaders get the same attributes (0: vec2 position, 1: vec2 uv, 2: vec4 color) and
+    // the "projection" uniform
+    class SpriteBatch {
+    public:
+        struct Stats {
+            std::size_t sprites = 0;
+            std::size_t draw_calls = 0;
+        };
+
+        SpriteBatch();
+
+        void begin();
+        void draw(const Sprite& sprite);
+        void end(const glm::mat4& projection);
+
+        [[nodiscard]] auto getStats() const -> const Stats&;
+
+        // multiplies the texture by the vertex color, also used by TextBatch
+        static auto getDefaultShader() -> const Shader&;
+
+    private:
+        struct Vertex {
+            glm::vec2 position;
+            glm::vec2 uv;
+            glm::u8vec4 color;
+        };
+
+        struct Batch {
+            const Shader* shader;
+            const Texture* texture;
+            std::size_t first_index;
+            std::size_t index_count;
+        };
+
+        auto slotOf(std::vector<const void*>& slots, const void* object) -> std::uint64_t;
+
+        // drawn when a sprite has no texture, shared so the batch stays movable
+        static auto getWhiteTexture() -> const Texture&;
+
+        std::vector<Sprite> m_sprites;
+        std::vector<std::pair<std::uint64_t, std::uint32_t>> m_order;
+        std::vector<const void*> m_shader_slots;
+        std::vector<const void*> m_texture_slots;
+        std::vector<Batch> m_batches;
+
+        VertexArray<glm::vec2, glm::vec2, glm::u8vec4> m_vertex_array;
+        Stats m_stats;
+    };
+
+}
@@ -0,0 +1,133 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#pragma once
+
+#include <sogl/Buffer.hpp>
+#include <sogl/UniformBuffer.hpp>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+// shader storage buffers are not part of WebGL
+#if !defined(EMSCRIPTEN)
+
+namespace sogl {
+    namespace detail {
+        // std430 is std140 without the rounding of arrays and structs to a vec4,
+        // matrix columns are only aligned as vectors of their size
+        template <typename T>
+        struct Std430Traits;
+
+        template <typename T> requires std::is_same_v<T, float> || std::is_same_v<T, int> || std::is_same_v<T, unsigned>
+        struct Std430Traits<T> : Std140Traits<T> {};
+
+        template <int N, typename T>
+        struct Std430Traits<glm::vec<N, T, glm::defaultp>> : Std140Traits<glm::vec<N, T, glm::defaultp>> {};
+
+        template <int C, int R>
+        struct Std430Traits<glm::mat<C, R, float, glm::defaultp>> {
+            static constexpr std::size_t alignment = Std140Traits<glm::vec<R, float, glm::defaultp>>::alignment;
+            static constexpr std::size_t size = C * alignment;
+        };
+
+        template <typename T, typename Members>
+        struct Std430Layout;
+
+        template <typename T, typename... Members>
+        struct Std430Layout<T, std::tuple<Members...>> {
+            // same check as Std140Layout, the array stride is the struct size rounded to its largest alignment
+            static constexpr bool matches = [] {
+                constexpr auto round_up = [](std::size_t value, std::size_t alignment) {
+                    return (value + alignment - 1) / alignment * alignment;
+                };
+                constexpr std::array<std::size_t, sizeof...(Members)> cpp_alignments = {alignof(Members)...};
+                constexpr std::array<std::size_t, sizeof...(Members)> cpp_sizes = {sizeof(Members)...};
+                constexpr std::array<std::size_t, sizeof...(Members)> alignments = {Std430Traits<Members>::alignment...};
+                constexpr std::array<std::size_t, sizeof...(Members)> sizes = {Std430Traits<Members>::size...};
+
+                auto cpp_offset = std::size_t(0);
+                auto offset = std::size_t(0);
+                auto struct_alignment = std::size_t(1);
+                for (std::size_t i = 0; i < sizeof...(Members); ++i) {
+                    cpp_offset = round_up(cpp_offset, cpp_alignments[i]);
+                    offset = round_up(offset, alignments[i]);
+                    if (cpp_offset != offset || cpp_sizes[i] != sizes[i])
+                        return false;
+                    cpp_offset += cpp_sizes[i];
+                    offset += sizes[i];
+                    struct_alignment = std::max(struct_alignment, alignments[i]);
+                }
+                return round_up(offset, struct_alignment) == sizeof(T);
+            }();
+        };
+
+        template <typename T>
+        constexpr auto is_std430_element() -> bool {
+            if constexpr (requires { Std430Traits<T>::alignment; }) {
+                // arrays of vec3 have a 16 bytes stride
+                return (Std430Traits<T>::size + Std430Traits<T>::alignment - 1) / Std430Traits<T>::alignment
+                       * Std430Traits<T>::alignment == sizeof(T);
+            } else {
+                return Std430Layout<T, decltype(members_of(std::declval<const T&>()))>::matches;
+            }
+        }
+
+        template <typename T>
+        inline constexpr bool is_std430_v = is_std430_element<T>();
+
+        // binding point of the shader storage blocks with this name, the same in every shader
+        auto storage_block_binding(const std::string& block_name) -> unsigned;
+    }
+
+    // an array of T in a shader storage block, read and written by compute and graphics shaders.
+    // the block holds a single unsized array member, T is laid out as std430 :
+    // 32 bits scalars, vectors and float matrices, padding written as explicit members.
+    // needs GL 4.3 or GL_ARB_shader_storage_buffer_object
+    template <typename T>
+    class StorageBuffer {
+        static_assert(std::is_trivially_copyable_v<T>, "storage buffer data must be trivially copyable");
+        static_assert(detail::is_std430_v<T>,
+                      "storage buffer data does not match the std430 layout, reorder its members or add padding members");
+
+    public:
+        // every shader sees the block with this name through the same binding point
+        explicit StorageBuffer(const std::string& block_name, std::size_t count = 0);
+        StorageBuffer(const StorageBuffer&) = delete;
+        StorageBuffer(StorageBuffer&&) = delete;
+        StorageBuffer& operator=(const StorageBuffer&) = delete;
+        StorageBuffer& operator=(StorageBuffer&&) = delete;
+
+        // the first elements are kept
+        void resize(std::size_t count);
+        void update(std::span<const T> data, std::size_t first = 0);
+
+        // waits for the GPU, call Shader::memoryBarrier(Barrier::BufferUpdate) after the writing dispatch
+        [[nodiscard]] auto read(std::size_t first = 0, std::size_t count = ~std::size_t(0)) const -> std::vector<T>;
+
+        // the buffer is bound on creation, bind it again when several buffers share a block name
+        void bind() const;
+
+        [[nodiscard]] auto getSize() const -> std::size_t;
+        [[nodiscard]] auto getBinding() const -> unsigned;
+
+    private:
+        Buffer<T> m_buffer;
+        unsigned m_binding = 0;
+        std::size_t m_size = 0;
+    };
+
+}
+
+#include <sogl/StorageBuffer.tpp>
+
+#endif
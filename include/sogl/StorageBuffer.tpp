@@ -0,0 +1,48 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#pragma once
+
+namespace sogl {
+
+    template <typename T>
+    StorageBuffer<T>::StorageBuffer(const std::string& block_name, std::size_t count) :
+    m_binding(detail::storage_block_binding(block_name)) {
+        resize(count);
+    }
+
+    template <typename T>
+    void StorageBuffer<T>::resize(std::size_t count) {
+        // a buffer of size 0 cannot be bound to an indexed binding point
+        m_buffer.resize(std::max<std::size_t>(count, 1));
+        m_size = count;
+        bind();
+    }
+
+    template <typename T>
+    void StorageBuffer<T>::update(std::span<const T> data, std::size_t first) {
+        assert(first + data.size() <= m_size);
+        m_buffer.update(data, first);
+    }
+
+    template <typename T>
+    auto StorageBuffer<T>::read(std::size_t first, std::size_t count) const -> std::vector<T> {
+        first = std::min(first, m_size);
+        return m_buffer.read(first, std::min(count, m_size - first));
+    }
+
+    template <typename T>
+    void StorageBuffer<T>::bind() const {
+        m_buffer.bindBase(BufferTarget::ShaderStorage, m_binding);
+    }
+
+    template <typename T>
+    auto StorageBuffer<T>::getSize() const -> std::size_t {
+        return m_size;
+    }
+
+    template <typename T>
+    auto StorageBuffer<T>::getBinding() const -> unsigned {
+        return m_binding;
+    }
+
+}
@@ -0,0 +1,59 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#pragma once
+
+#include <sogl/Font.hpp>
+#include <sogl/VertexArray.hpp>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+#include <glm/gtc/type_precision.hpp>
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace sogl {
+
+    // collects the strings of a frame and draws them with one draw call per glyph page (font and size).
+    // glyph quads are written while the text is shaped, straight into a streaming vertex array
+    class TextBatch {
+    public:
+        struct Stats {
+            std::size_t glyphs = 0;
+            std::size_t draw_calls = 0;
+        };
+
+        TextBatch();
+
+        void begin();
+        // position is the left end of the baseline
+        void draw(Font& font, std::string_view text, int size, const glm::vec2& position,
+                  const glm::vec4& color = {1.f, 1.f, 1.f, 1.f});
+        void end(const glm::mat4& projection);
+
+        [[nodiscard]] auto getStats() const -> const Stats&;
+
+    private:
+        struct Vertex {
+            glm::vec2 position;
+            glm::vec2 uv;
+            glm::u8vec4 color;
+        };
+
+        struct Page {
+            const Font* font;
+            int size;
+            std::vector<unsigned> indices;
+            std::size_t first_index = 0;
+        };
+
+        auto pageOf(const Font& font, int size) -> Page&;
+
+        std::vector<Page> m_pages;
+        VertexArray<glm::vec2, glm::vec2, glm::u8vec4> m_vertex_array;
+        Stats m_stats;
+    };
+
+}
@@ -8,6 +8,9 @@
 
 namespace sogl {
 
+    template <typename T>
+    class Buffer;
+
     class Texture {
     public:
         Texture();
@@ -22,8 +25,16 @@ namespace sogl {
         auto load(const std::filesystem::path& file) -> bool;
 
         auto copy(const std::uint8_t* pixels, int x, int y, int width, int height) -> bool;
+        // rgba pixels from a pixel unpack buffer, filled through Buffer::map while the GPU keeps drawing
+        auto copy(const Buffer<std::uint8_t>& pixels, int x, int y, int width, int height) -> bool;
+
+        void bind(unsigned unit = 0) const;
 
-        void bind() const;
+#if !defined(EMSCRIPTEN)
+        // binds the first level as a rgba8 image for load and store from compute shaders.
+        // mipmaps are not updated by the writes
+        void bindImage(unsigned unit = 0) const;
+#endif
 
         static void unbind();
 
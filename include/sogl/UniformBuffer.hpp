@@ -0,0 +1,195 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#pragma once
+
+#include <sogl/Buffer.hpp>
+#include <sogl/Vertex.hpp>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace sogl {
+    namespace detail {
+        // base alignment and size of a member of a std140 block
+        template <typename T>
+        struct Std140Traits;
+
+        template <typename T> requires std::is_same_v<T, float> || std::is_same_v<T, int> || std::is_same_v<T, unsigned>
+        struct Std140Traits<T> {
+            static constexpr std::size_t alignment = 4;
+            static constexpr std::size_t size = 4;
+        };
+
+        template <int N, typename T>
+        struct Std140Traits<glm::vec<N, T, glm::defaultp>> {
+            static constexpr std::size_t alignment = N == 1 ? 4 : N == 2 ? 8 : 16;
+            static constexpr std::size_t size = N * Std140Traits<T>::size;
+        };
+
+        // matrices are arrays of column vectors, each column is aligned on a vec4
+        template <int C, int R>
+        struct Std140Traits<glm::mat<C, R, float, glm::defaultp>> {
+            static_assert(R == 4, "std140 pads matrix columns to a vec4, declare a glsl mat3 as glm::mat3x4 "
+                                  "and a mat2 as glm::mat2x4");
+            static constexpr std::size_t alignment = 16;
+            static constexpr std::size_t size = C * 16;
+        };
+
+        // empty braces initialize a whole member, even an array or a struct
+        template <typename T>
+        consteval auto member_count() -> std::size_t {
+            if constexpr(requires { T{{}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}}; }) return 13;
+            else if constexpr(requires { T{{}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}}; }) return 12;
+            else if constexpr(requires { T{{}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}}; }) return 11;
+            else if constexpr(requires { T{{}, {}, {}, {}, {}, {}, {}, {}, {}, {}}; }) return 10;
+            else if constexpr(requires { T{{}, {}, {}, {}, {}, {}, {}, {}, {}}; }) return 9;
+            else if constexpr(requires { T{{}, {}, {}, {}, {}, {}, {}, {}}; }) return 8;
+            else if constexpr(requires { T{{}, {}, {}, {}, {}, {}, {}}; }) return 7;
+            else if constexpr(requires { T{{}, {}, {}, {}, {}, {}}; }) return 6;
+            else if constexpr(requires { T{{}, {}, {}, {}, {}}; }) return 5;
+            else if constexpr(requires { T{{}, {}, {}, {}}; }) return 4;
+            else if constexpr(requires { T{{}, {}, {}}; }) return 3;
+            else if constexpr(requires { T{{}, {}}; }) return 2;
+            else if constexpr(requires { T{{}}; }) return 1;
+            else return 0;
+        }
+
+        // brace elision lets an array or struct member take one initializer per element,
+        // the struct then accepts more initializers than it has members
+        template <typename T, std::size_t... Is>
+        consteval auto has_aggregate_member(std::index_sequence<Is...>) -> bool {
+            return requires { T{(void(Is), any_type())..., any_type()}; };
+        }
+
+        template <class T>
+        auto members_of(T&& object) {
+            using type = std::decay_t<T>;
+            using any = any_type;
+            constexpr auto count = member_count<type>();
+            constexpr auto aggregate_member = count <= 12
+                                              && has_aggregate_member<type>(std::make_index_sequence<count>());
+            static_assert(count <= 12, "uniform and storage buffer data can have at most 12 members");
+            static_assert(!aggregate_member, "uniform and storage buffer data cannot have array or struct members, "
+                                             "declare each element as its own member");
+            if constexpr(count > 12 || aggregate_member) {
+                return std::make_tuple();
+            } else if constexpr(is_brace_constructible_v<type, any, any, any, any, any, any, any, any, any, any, any, any>) {
+                auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12] = object;
+                return std::make_tuple(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12);
+            } else if constexpr(is_brace_constructible_v<type, any, any, any, any, any, any, any, any, any, any, any>) {
+                auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11] = object;
+                return std::make_tuple(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11);
+            } else if constexpr(is_brace_constructible_v<type, any, any, any, any, any, any, any, any, any, any>) {
+                auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10] = object;
+                return std::make_tuple(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10);
+            } else if constexpr(is_brace_constructible_v<type, any, any, any, any, any, any, any, any, any>) {
+                auto&& [p1, p2, p3, p4, p5, p6, p7, p8, p9] = object;
+                return std::make_tuple(p1, p2, p3, p4, p5, p6, p7, p8, p9);
+            } else if constexpr(is_brace_constructible_v<type, any, any, any, any, any, any, any, any>) {
+                auto&& [p1, p2, p3, p4, p5, p6, p7, p8] = object;
+                return std::make_tuple(p1, p2, p3, p4, p5, p6, p7, p8);
+            } else if constexpr(is_brace_constructible_v<type, any, any, any, any, any, any, any>) {
+                auto&& [p1, p2, p3, p4, p5, p6, p7] = object;
+                return std::make_tuple(p1, p2, p3, p4, p5, p6, p7);
+            } else if constexpr(is_brace_constructible_v<type, any, any, any, any, any, any>) {
+                auto&& [p1, p2, p3, p4, p5, p6] = object;
+                return std::make_tuple(p1, p2, p3, p4, p5, p6);
+            } else if constexpr(is_brace_constructible_v<type, any, any, any, any, any>) {
+                auto&& [p1, p2, p3, p4, p5] = object;
+                return std::make_tuple(p1, p2, p3, p4, p5);
+            } else if constexpr(is_brace_constructible_v<type, any, any, any, any>) {
+                auto&& [p1, p2, p3, p4] = object;
+                return std::make_tuple(p1, p2, p3, p4);
+            } else if constexpr(is_brace_constructible_v<type, any, any, any>) {
+                auto&& [p1, p2, p3] = object;
+                return std::make_tuple(p1, p2, p3);
+            } else if constexpr(is_brace_constructible_v<type, any, any>) {
+                auto&& [p1, p2] = object;
+                return std::make_tuple(p1, p2);
+            } else if constexpr(is_brace_constructible_v<type, any>) {
+                auto&& [p1] = object;
+                return std::make_tuple(p1);
+            } else {
+                return std::make_tuple();
+            }
+        }
+
+        template <typename T, typename Members>
+        struct Std140Layout;
+
+        template <typename T, typename... Members>
+        struct Std140Layout<T, std::tuple<Members...>> {
+            // the C++ members must land at the same offsets as the std140 ones
+            static constexpr bool matches = [] {
+                constexpr auto round_up = [](std::size_t value, std::size_t alignment) {
+                    return (value + alignment - 1) / alignment * alignment;
+                };
+                constexpr std::array<std::size_t, sizeof...(Members)> cpp_alignments = {alignof(Members)...};
+                constexpr std::array<std::size_t, sizeof...(Members)> cpp_sizes = {sizeof(Members)...};
+                constexpr std::array<std::size_t, sizeof...(Members)> alignments = {Std140Traits<Members>::alignment...};
+                constexpr std::array<std::size_t, sizeof...(Members)> sizes = {Std140Traits<Members>::size...};
+
+                auto cpp_offset = std::size_t(0);
+                auto offset = std::size_t(0);
+                for (std::size_t i = 0; i < sizeof...(Members); ++i) {
+                    cpp_offset = round_up(cpp_offset, cpp_alignments[i]);
+                    offset = round_up(offset, alignments[i]);
+                    if (cpp_offset != offset || cpp_sizes[i] != sizes[i])
+                        return false;
+                    cpp_offset += cpp_sizes[i];
+                    offset += sizes[i];
+                }
+                // the block size is rounded up to a vec4
+                return round_up(offset, 16) == sizeof(T);
+            }();
+        };
+
+        template <typename T>
+        inline constexpr bool is_std140_v = Std140Layout<T, decltype(members_of(std::declval<const T&>()))>::matches;
+
+        // binding point of the uniform blocks with this name, the same in every shader
+        auto uniform_block_binding(const std::string& block_name) -> unsigned;
+    }
+
+    // a uniform block filled from a C++ struct in one upload.
+    // the struct has at most 12 members, declared in the block order and laid out as std140 : float, int,
+    // unsigned, glm vectors of those and float matrices of 4 rows (glm::mat4, glm::mat3x4 for a glsl mat3,
+    // glm::mat2x4 for a mat2). arrays and nested structs are not supported, padding is written as explicit
+    // members, alignas is not taken into account
+    template <typename T>
+    class UniformBuffer {
+        static_assert(std::is_trivially_copyable_v<T> && std::is_aggregate_v<T>,
+                      "uniform buffer data must be a trivially copyable aggregate");
+        static_assert(detail::is_std140_v<T>,
+                      "uniform buffer data does not match the std140 layout, reorder its members or add padding members");
+
+    public:
+        // every shader sees the block with this name through the same binding point
+        explicit UniformBuffer(const std::string& block_name);
+        UniformBuffer(const UniformBuffer&) = delete;
+        UniformBuffer(UniformBuffer&&) = delete;
+        UniformBuffer& operator=(const UniformBuffer&) = delete;
+        UniformBuffer& operator=(UniformBuffer&&) = delete;
+
+        void update(const T& data);
+
+        // the buffer is bound on creation, bind it again when several buffers share a block name
+        void bind() const;
+
+        [[nodiscard]] auto getBinding() const -> unsigned;
+
+    private:
+        Buffer<T> m_buffer;
+        unsigned m_binding = 0;
+    };
+
+}
+
+#include <sogl/UniformBuffer.tpp>
@@ -0,0 +1,29 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#pragma once
+
+namespace sogl {
+
+    template <typename T>
+    UniformBuffer<T>::UniformBuffer(const std::string& block_name) :
+    m_buffer(1, BufferUsage::DynamicDraw),
+    m_binding(detail::uniform_block_binding(block_name)) {
+        bind();
+    }
+
+    template <typename T>
+    void UniformBuffer<T>::update(const T& data) {
+        m_buffer.update(std::span<const T>(&data, 1));
+    }
+
+    template <typename T>
+    void UniformBuffer<T>::bind() const {
+        m_buffer.bindBase(BufferTarget::Uniform, m_binding);
+    }
+
+    template <typename T>
+    auto UniformBuffer<T>::getBinding() const -> unsigned {
+        return m_binding;
+    }
+
+}
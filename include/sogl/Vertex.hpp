@@ -4,10 +4,17 @@
 
 #include <GL/glew.h>
 #include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
+#include <glm/gtc/packing.hpp>
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
 #include <tuple>
+#include <type_traits>
 
 namespace sogl {
     namespace detail {
@@ -20,6 +27,126 @@ namespace sogl {
         inline constexpr bool is_brace_constructible_v = requires { T{std::declval<Args>()...}; };
     }
 
+    // 16 bits floating point vector attribute
+    template <int N>
+    struct HalfVec {
+        HalfVec() = default;
+        HalfVec(const glm::vec<N, float>& v) {
+            for (int i = 0; i < N; ++i)
+                bits[i] = glm::packHalf1x16(v[i]);
+        }
+
+        std::array<std::uint16_t, N> bits = {};
+    };
+    using half2 = HalfVec<2>;
+    using half3 = HalfVec<3>;
+    using half4 = HalfVec<4>;
+
+    // signed normalized xyz on 10 bits each and w on 2 bits, for normals and tangents
+    struct PackedNormal {
+        PackedNormal() = default;
+        PackedNormal(const glm::vec4& v) : bits(glm::packSnorm3x10_1x2(v)) {}
+        PackedNormal(const glm::vec3& v) : PackedNormal(glm::vec4(v, 0.f)) {}
+
+        std::uint32_t bits = 0;
+    };
+
+    // 8 and 16 bits integers are normalized to floats by default, wrap them in Integer to read them as ints
+    template <typename T>
+    struct Integer {
+        Integer() = default;
+        Integer(const T& v) : value(v) {}
+
+        T value = {};
+    };
+
+    // describes how an attribute type is read by the vertex shader, specialize it to support other types
+    template <typename T>
+    struct AttribTraits;
+
+    namespace detail {
+        template <typename T>
+        constexpr auto gl_type() -> GLenum {
+            if constexpr (std::is_same_v<T, float>) return GL_FLOAT;
+            else if constexpr (std::is_same_v<T, std::int8_t>) return GL_BYTE;
+            else if constexpr (std::is_same_v<T, std::uint8_t>) return GL_UNSIGNED_BYTE;
+            else if constexpr (std::is_same_v<T, std::int16_t>) return GL_SHORT;
+            else if constexpr (std::is_same_v<T, std::uint16_t>) return GL_UNSIGNED_SHORT;
+            else if constexpr (std::is_same_v<T, std::int32_t>) return GL_INT;
+            else if constexpr (std::is_same_v<T, std::uint32_t>) return GL_UNSIGNED_INT;
+            else static_assert(sizeof(T) == 0, "Unsupported vertex attribute component type");
+        }
+
+        template <typename T, int N>
+        struct ComponentTraits {
+            static constexpr int components = N;
+            static constexpr GLenum type = gl_type<T>();
+            static constexpr bool integer = std::is_integral_v<T> && sizeof(T) == 4;
+            static constexpr bool normalized = std::is_integral_v<T> && !integer;
+        };
+    }
+
+    template <typename T> requires std::is_arithmetic_v<T>
+    struct AttribTraits<T> : detail::ComponentTraits<T, 1> {};
+
+    template <int N, typename T, glm::qualifier Q>
+    struct AttribTraits<glm::vec<N, T, Q>> : detail::ComponentTraits<T, N> {};
+
+    template <int N>
+    struct AttribTraits<HalfVec<N>> {
+        static constexpr int components = N;
+        static constexpr GLenum type = GL_HALF_FLOAT;
+        static constexpr bool integer = false;
+        static constexpr bool normalized = false;
+    };
+
+    template <>
+    struct AttribTraits<PackedNormal> {
+        static constexpr int components = 4;
+        static constexpr GLenum type = GL_INT_2_10_10_10_REV;
+        static constexpr bool integer = false;
+        static constexpr bool normalized = true;
+    };
+
+    template <typename T>
+    struct AttribTraits<Integer<T>> : AttribTraits<T> {
+        static constexpr bool integer = true;
+        static constexpr bool normalized = false;
+    };
+
+    // matrices use one attribute location per column
+    template <int C, int R, glm::qualifier Q>
+    struct AttribTraits<glm::mat<C, R, float, Q>> : detail::ComponentTraits<float, R> {
+        static constexpr int locations = C;
+    };
+
+    namespace detail {
+        template <typename T>
+        constexpr auto attrib_locations() -> unsigned {
+            if constexpr (requires { AttribTraits<T>::locations; })
+                return AttribTraits<T>::locations;
+            else
+                return 1;
+        }
+
+        // what a vertex array feeds at one attribute location, checked against the inputs of the program in use
+        struct VertexInputDesc {
+            unsigned location;
+            bool integer;
+        };
+
+        template <typename... AttrTypes>
+        constexpr auto vertex_input_descs(unsigned first_location = 0) {
+            auto descs = std::array<VertexInputDesc, (attrib_locations<AttrTypes>() + ... + 0)>{};
+            auto n = 0u;
+            ([&] {
+                for (unsigned i = 0; i < attrib_locations<AttrTypes>(); ++i, ++n)
+                    descs[n] = {first_location + n, AttribTraits<AttrTypes>::integer};
+            }(), ...);
+            return descs;
+        }
+    }
+
     enum class Primitive : GLenum {
         Points = GL_POINTS,
         Lines = GL_LINES,
@@ -35,6 +162,50 @@ namespace sogl {
         Patches = GL_PATCHES,
     };
 
+    enum class IndexType : GLenum {
+        Auto = 0,
+        UnsignedByte = GL_UNSIGNED_BYTE,
+        UnsignedShort = GL_UNSIGNED_SHORT,
+        UnsignedInt = GL_UNSIGNED_INT,
+    };
+
+    namespace detail {
+        // smallest index type that can address all the vertices, 8 bits indices are left out of the automatic
+        // selection because desktop hardware often does not support them natively.
+        // a requested type too narrow for the vertices is widened instead of truncating the indices
+        inline auto select_index_type(IndexType type, std::size_t vertex_count) -> IndexType {
+            if (type == IndexType::UnsignedByte && vertex_count <= 0x100)
+                return type;
+            if (type == IndexType::UnsignedInt)
+                return type;
+            return vertex_count <= 0x10000 ? IndexType::UnsignedShort : IndexType::UnsignedInt;
+        }
+
+        inline auto index_size(IndexType type) -> std::size_t {
+            switch (type) {
+                case IndexType::UnsignedByte: return sizeof(std::uint8_t);
+                case IndexType::UnsignedShort: return sizeof(std::uint16_t);
+                default: return sizeof(std::uint32_t);
+            }
+        }
+
+        inline void pack_indices(IndexType type, const unsigned* src, std::size_t count, std::byte* dst) {
+            switch (type) {
+                case IndexType::UnsignedByte:
+                    for (std::size_t i = 0; i < count; ++i)
+                        reinterpret_cast<std::uint8_t*>(dst)[i] = static_cast<std::uint8_t>(src[i]);
+                    break;
+                case IndexType::UnsignedShort:
+                    for (std::size_t i = 0; i < count; ++i)
+                        reinterpret_cast<std::uint16_t*>(dst)[i] = static_cast<std::uint16_t>(src[i]);
+                    break;
+                default:
+                    std::memcpy(dst, src, count * sizeof(unsigned));
+                    break;
+            }
+        }
+    }
+
     template<class T>
     auto vertex(T&& object) noexcept {
         using type = std::decay_t<T>;
@@ -61,4 +232,100 @@ namespace sogl {
             return std::make_tuple();
         }
     }
+
+    namespace detail {
+        // interleaved layout of a vertex, attributes are tightly packed in declaration order
+        template <typename... AttrTypes>
+        struct VertexLayout {
+            static constexpr auto count = sizeof...(AttrTypes);
+            static constexpr auto stride = (sizeof(AttrTypes) + ...);
+            static constexpr std::array<std::size_t, count> sizes = {sizeof(AttrTypes)...};
+            static constexpr std::array<std::size_t, count> offsets = [] {
+                auto result = std::array<std::size_t, count>{};
+                auto offset = std::size_t(0);
+                for (std::size_t i = 0; i < count; ++i) {
+                    result[i] = offset;
+                    offset += sizes[i];
+                }
+                return result;
+            }();
+
+            template <unsigned I = 0>
+            static void write(std::byte* dst, const std::tuple<AttrTypes...>& vert);
+
+            template <typename VertexStruct>
+            static void store(std::byte* dst, const VertexStruct& v);
+
+            template <typename VertexStruct>
+            static void storeRange(std::byte* dst, std::span<const VertexStruct> vertices);
+        };
+
+        // a vertex struct with the exact same memory layout as the packed attributes, it can be copied as is
+        template <typename T, typename... AttrTypes>
+        concept packed_vertex = std::is_trivially_copyable_v<T>
+                                && sizeof(T) == VertexLayout<AttrTypes...>::stride
+                                && std::is_same_v<decltype(vertex(std::declval<const T&>())), std::tuple<AttrTypes...>>;
+
+        template <typename... AttrTypes>
+        template <unsigned I>
+        void VertexLayout<AttrTypes...>::write(std::byte* dst, const std::tuple<AttrTypes...>& vert) {
+            // tuple elements order in memory is implementation defined, each attribute is copied to its packed offset
+            std::memcpy(dst + offsets[I], &std::get<I>(vert), sizes[I]);
+
+            if constexpr(I < count - 1) {
+                write<I+1>(dst, vert);
+            }
+        }
+
+        template <typename... AttrTypes>
+        template <typename VertexStruct>
+        void VertexLayout<AttrTypes...>::store(std::byte* dst, const VertexStruct& v) {
+            if constexpr (std::is_same_v<VertexStruct, std::tuple<AttrTypes...>>) {
+                write(dst, v);
+            } else if constexpr (packed_vertex<VertexStruct, AttrTypes...>) {
+                std::memcpy(dst, &v, stride);
+            } else {
+                write(dst, vertex(v));
+            }
+        }
+
+        template <typename... AttrTypes>
+        template <typename VertexStruct>
+        void VertexLayout<AttrTypes...>::storeRange(std::byte* dst, std::span<const VertexStruct> vertices) {
+            if constexpr (packed_vertex<VertexStruct, AttrTypes...>) {
+                std::memcpy(dst, vertices.data(), vertices.size_bytes());
+            } else {
+                for (const auto& v : vertices) {
+                    store(dst, v);
+                    dst += stride;
+                }
+            }
+        }
+
+        // points the attributes at the buffer bound to GL_ARRAY_BUFFER, starting at the given location
+        template <typename AttribLayout, unsigned I, typename AttribT, typename... AttribTs>
+        void enable_vertex_attribs(unsigned location = 0, unsigned divisor = 0) {
+            using Traits = AttribTraits<AttribT>;
+            constexpr auto locations = attrib_locations<AttribT>();
+
+            for (unsigned i = 0; i < locations; ++i) {
+                const auto offset = AttribLayout::offsets[I] + i * AttribLayout::sizes[I] / locations;
+
+                glEnableVertexAttribArray(location + i);
+                if constexpr (Traits::integer) {
+                    glVertexAttribIPointer(location + i, Traits::components, Traits::type, AttribLayout::stride, (void*) offset);
+                } else {
+                    glVertexAttribPointer(location + i, Traits::components, Traits::type, Traits::normalized,
+                                          AttribLayout::stride, (void*) offset);
+                }
+                if (divisor != 0) {
+                    glVertexAttribDivisor(location + i, divisor);
+                }
+            }
+
+            if constexpr (sizeof...(AttribTs) > 0) {
+                enable_vertex_attribs<AttribLayout, I + 1, AttribTs...>(location + locations, divisor);
+            }
+        }
+    }
 }
@@ -2,28 +2,144 @@
 
 #pragma once
 
+#include <sogl/Buffer.hpp>
+#include <sogl/GlState.hpp>
+#include <sogl/MeshOptimizer.hpp>
+#include <sogl/Quantization.hpp>
+#include <sogl/ShaderReflection.hpp>
 #include <sogl/Vertex.hpp>
 
+#include <algorithm>
 #include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <initializer_list>
+#include <optional>
+#include <cstring>
+#include <span>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace sogl {
     namespace detail {
         template <typename T, typename TupleT>
         concept convertible_to_tuple = std::is_aggregate_v<T> && (sizeof(T) == sizeof(TupleT));
+
+        // sorted list of disjoint [first, last) ranges, touching ranges are merged together
+        class DirtyRanges {
+            static constexpr std::size_t max_ranges = 16;
+
+        public:
+            void add(std::size_t first, std::size_t last) {
+                if (first >= last)
+                    return;
+
+                auto it = std::lower_bound(m_ranges.begin(), m_ranges.end(), first,
+                                           [](const auto& range, std::size_t value) { return range.second < value; });
+                auto merge_end = it;
+                while (merge_end != m_ranges.end() && merge_end->first <= last) {
+                    first = std::min(first, merge_end->first);
+                    last = std::max(last, merge_end->second);
+                    ++merge_end;
+                }
+                it = m_ranges.erase(it, merge_end);
+                m_ranges.insert(it, {first, last});
+
+                // too many small uploads cost more than a single bigger one
+                if (m_ranges.size() > max_ranges) {
+                    m_ranges = {{m_ranges.front().first, m_ranges.back().second}};
+                }
+            }
+
+            void clear() { m_ranges.clear(); }
+
+            [[nodiscard]] auto empty() const -> bool { return m_ranges.empty(); }
+            [[nodiscard]] auto begin() const { return m_ranges.begin(); }
+            [[nodiscard]] auto end() const { return m_ranges.end(); }
+
+        private:
+            std::vector<std::pair<std::size_t, std::size_t>> m_ranges;
+        };
+
+        // uploads the dirty ranges, the buffer is reallocated when too small
+        inline void upload_ranges(Buffer<std::byte>& buffer, const std::vector<std::byte>& data, std::size_t stride,
+                                  DirtyRanges& ranges) {
+            const auto count = data.size() / stride;
+            if (data.size() > buffer.getSize()) {
+                // grow geometrically, the whole content is uploaded again after a reallocation.
+                // the name is kept, the vertex array attachments stay valid
+                buffer.create(std::max(data.size(), buffer.getSize() * 2), BufferUsage::DynamicDraw);
+                ranges.clear();
+                ranges.add(0, count);
+            }
+            for (auto [first, last] : ranges) {
+                last = std::min(last, count);
+                if (first >= last)
+                    continue;
+
+                buffer.update(std::span(data).subspan(first * stride, (last - first) * stride), first * stride);
+            }
+            ranges.clear();
+        }
+
+        // uploads data that never changes, in immutable storage when available.
+        // the buffer may get a new name that must be attached again
+        inline void upload_static(Buffer<std::byte>& buffer, std::span<const std::byte> data) {
+#if !defined(EMSCRIPTEN)
+            if (Buffer<std::byte>::isStorageSupported()) {
+                buffer.create(data.size(), BufferStorage::None, data.data());
+                return;
+            }
+#endif
+            buffer.create(data.size(), BufferUsage::StaticDraw, data.data());
+        }
     }
 
     template <typename... AttrTypes>
     class VertexArray {
         using VertexTuple = std::tuple<AttrTypes...>;
+        using Layout = detail::VertexLayout<AttrTypes...>;
 
     public:
+        // a VertexArray with a second, per instance, attribute stream
+        template <typename... InstanceTypes>
+        class Instances;
+
         explicit VertexArray(Primitive primitive_type = Primitive::Triangles);
+        virtual ~VertexArray();
+        VertexArray(const VertexArray&) = delete;
+        VertexArray(VertexArray&& other) noexcept;
+        VertexArray& operator=(const VertexArray&) = delete;
+        VertexArray& operator=(VertexArray&& other) noexcept;
 
         void setPrimitiveType(sogl::Primitive primitive_type);
 
+        // by default the index type is the smallest one that can address all the vertices,
+        // a narrower type is widened once there are too many vertices for it
+        void setIndexType(IndexType index_type);
+
+        // for geometry rebuilt every frame : the pushed vertices and indices are written straight into a ring
+        // of mapped buffer regions, fenced so that the CPU never writes a region the GPU still draws from.
+        // clear() moves on to the next region. there is no CPU copy of the geometry while streaming and the
+        // indices are 32 bits whatever the index type. 0 goes back to the regular buffers
+        void setStreaming(unsigned frames_in_flight = 3);
+
+        // uploads the geometry once and releases the CPU copies, for geometry that never changes.
+        // a frozen VertexArray can't be modified anymore, clear() makes it editable again
+        void freeze();
+        [[nodiscard]] auto isFrozen() const -> bool { return m_frozen; }
+
+        // merges identical vertices and reorders the triangles and vertices for the GPU caches,
+        // only meaningful for triangle lists. not available while streaming
+        auto optimize(unsigned cache_size = 16) -> MeshOptimizationReport;
+
+        // for quantized positions (see Quantizer), the matrix is set to the "dequantize" uniform of
+        // the program in use when binding
+        void setDequantization(const glm::mat4& dequantization);
+
         void clear();
 
         void push(const VertexTuple& v);
@@ -32,42 +148,249 @@ namespace sogl {
 
         template <detail::convertible_to_tuple<VertexTuple> VertexStruct>
         void push(const VertexStruct& v) {
-            push(vertex(v));
+            pushPrimitive(std::array<VertexStruct, 1>{v}, {0});
         }
 
         template <detail::convertible_to_tuple<VertexTuple> VertexStruct>
         void pushTriangle(const std::array<VertexStruct, 3>& vertices) {
-            pushTriangle({{ vertex(vertices[0]), vertex(vertices[1]), vertex(vertices[2]) }});
+            pushPrimitive(vertices, {0, 1, 2});
         }
 
         template <detail::convertible_to_tuple<VertexTuple> VertexStruct>
         void pushQuad(const std::array<VertexStruct, 4>& vertices) {
-            pushQuad({{ vertex(vertices[0]), vertex(vertices[1]), vertex(vertices[2]), vertex(vertices[3]) }});
+            pushPrimitive(vertices, {0, 1, 2, 0, 2, 3});
         }
 
-        void bind() const;
+        // push contiguous vertices, structs matching the packed layout are copied with a single memcpy
+        template <typename VertexStruct>
+            requires std::same_as<VertexStruct, VertexTuple> || detail::convertible_to_tuple<VertexStruct, VertexTuple>
+        void pushVertices(std::span<const VertexStruct> vertices) {
+            const auto base_vertex = static_cast<unsigned>(getVertexCount());
+            Layout::storeRange(allocateVertices(vertices.size()), vertices);
+
+            auto* indices = allocateIndices(vertices.size());
+            for (std::size_t i = 0; i < vertices.size(); ++i) {
+                indices[i] = base_vertex + i;
+            }
+        }
+
+        // push vertices with their own indices, relative to the first vertex of the span
+        template <typename VertexStruct>
+            requires std::same_as<VertexStruct, VertexTuple> || detail::convertible_to_tuple<VertexStruct, VertexTuple>
+        void append(std::span<const VertexStruct> vertices, std::span<const unsigned> indices) {
+            const auto base_vertex = static_cast<unsigned>(getVertexCount());
+            Layout::storeRange(allocateVertices(vertices.size()), vertices);
+
+            auto* dst = allocateIndices(indices.size());
+            for (std::size_t i = 0; i < indices.size(); ++i) {
+                dst[i] = base_vertex + indices[i];
+            }
+        }
+
+        // every 4 vertices make a quad, indexed the same way as pushQuad
+        template <typename VertexStruct>
+            requires std::same_as<VertexStruct, VertexTuple> || detail::convertible_to_tuple<VertexStruct, VertexTuple>
+        void pushQuads(std::span<const VertexStruct> vertices) {
+            const auto quad_count = vertices.size() / 4;
+            const auto base_vertex = static_cast<unsigned>(getVertexCount());
+            Layout::storeRange(allocateVertices(quad_count * 4), vertices.first(quad_count * 4));
+
+            auto* indices = allocateIndices(quad_count * 6);
+            for (std::size_t q = 0; q < quad_count; ++q) {
+                const auto first = base_vertex + static_cast<unsigned>(q * 4);
+                indices[q * 6 + 0] = first;
+                indices[q * 6 + 1] = first + 1;
+                indices[q * 6 + 2] = first + 2;
+                indices[q * 6 + 3] = first;
+                indices[q * 6 + 4] = first + 2;
+                indices[q * 6 + 5] = first + 3;
+            }
+        }
+
+        // storage handed out by emplace, valid until the next push, clear or reserve, and until bind while streaming
+        struct Writer {
+            std::byte* vertices;    // count * stride bytes, in the packed layout
+            unsigned* indices;      // absolute indices, add base_vertex to the local ones
+            unsigned base_vertex;
+
+            void write(std::size_t i, const VertexTuple& v) { Layout::write(vertices + i * Layout::stride, v); }
+
+            template <detail::convertible_to_tuple<VertexTuple> VertexStruct>
+            void write(std::size_t i, const VertexStruct& v) { Layout::store(vertices + i * Layout::stride, v); }
+
+            // structs with the exact packed layout can be written in place
+            template <detail::packed_vertex<AttrTypes...> VertexStruct>
+            auto as() const -> VertexStruct* { return reinterpret_cast<VertexStruct*>(vertices); }
+        };
+
+        // allocates the vertices and indices without writing them, the caller fills the whole storage
+        auto emplace(std::size_t vertex_count, std::size_t index_count) -> Writer;
+
+        // avoids reallocations when the final size of the geometry is known
+        void reserve(std::size_t vertex_count, std::size_t index_count);
+
+        // modify vertices in place, only the modified ranges are uploaded on next bind
+        void update(std::size_t index, const VertexTuple& v);
+        void updateRange(std::size_t first, std::span<const VertexTuple> vertices);
+
+        template <detail::convertible_to_tuple<VertexTuple> VertexStruct>
+        void update(std::size_t index, const VertexStruct& v) {
+            Layout::store(editVertices(index, 1), v);
+        }
+
+        template <detail::convertible_to_tuple<VertexTuple> VertexStruct>
+        void updateRange(std::size_t first, std::span<const VertexStruct> vertices) {
+            Layout::storeRange(editVertices(first, vertices.size()), vertices);
+        }
+
+        [[nodiscard]] auto getVertexCount() const -> std::size_t {
+            if (m_frozen)
+                return m_frozen_vertex_count;
+            return m_stream.frames > 0 ? m_stream.vertex_count : m_vertices.size() / Layout::stride;
+        }
+        [[nodiscard]] auto getIndexCount() const -> std::size_t {
+            if (m_frozen)
+                return m_frozen_index_count;
+            return m_stream.frames > 0 ? m_stream.index_count : m_indices.size();
+        }
+        [[nodiscard]] auto getIndexType() const -> IndexType;
+
+        // Instances also uploads its instance data, even when bound through a VertexArray reference
+        virtual void bind() const;
         void render() const;
+        // draws index_count indices starting at first_index, to render parts of the vertex array with different states
+        void renderRange(std::size_t first_index, std::size_t index_count) const;
 
     private:
         void create();
+        // attaches the buffers to the vao, after they got a new name
+        void attachBuffers() const;
+
+        template <typename VertexStruct, std::size_t N>
+        void pushPrimitive(const std::array<VertexStruct, N>& vertices, std::initializer_list<unsigned> indices);
 
-        template <unsigned I, typename AttribT, typename... AttribTs>
-        void enableVertexAttribs(size_t offset = 0);
+        auto allocateVertices(std::size_t count) -> std::byte*;
+        auto allocateIndices(std::size_t count) -> unsigned*;
+        // storage of vertices already pushed, marked to be uploaded again
+        auto editVertices(std::size_t first, std::size_t count) -> std::byte*;
 
-        template <unsigned I = 0>
-        void pushVertexToBuffer(std::vector<float>& vec, const VertexTuple& vert) const;
+        void draw(std::size_t first_index, std::size_t index_count, std::size_t instance_count) const;
+        void uploadRanges() const;
+
+        // the geometry of the current frame is kept when the ring grows
+        void reserveStream(std::size_t vertex_count, std::size_t index_count);
+        void allocateStreamRing(std::size_t vertex_capacity, std::size_t index_capacity);
+        void releaseStreamRing();
+        void mapStreamRegion();
+        void unmapStreamRegion() const;
+        // fences the current region once it was drawn from and moves on to the next one
+        void nextStreamRegion();
+        // copies the current frame back to m_vertices and m_indices, when leaving the streaming mode
+        void readStream();
+
+        static constexpr auto vertex_locations = (detail::attrib_locations<AttrTypes>() + ...);
+        static constexpr auto vertex_inputs = detail::vertex_input_descs<AttrTypes...>();
 
         Primitive m_primitive_type;
+        IndexType m_index_type = IndexType::Auto;
 
         unsigned m_vao = 0;
-        unsigned m_vbo = 0;
-        unsigned m_ibo = 0;
+        mutable Buffer<std::byte> m_vbo;
+        mutable Buffer<std::byte> m_ibo;
 
-        std::vector<VertexTuple> m_vertices;
+        // every attribute location fed by the vertex array, instances included
+        std::span<const detail::VertexInputDesc> m_inputs = vertex_inputs;
+
+        // vertices are stored interleaved, exactly as they are uploaded
+        std::vector<std::byte> m_vertices;
         std::vector<unsigned> m_indices;
 
-        mutable std::vector<float> m_buffer;
         mutable bool m_dirty = false;
+        mutable detail::DirtyRanges m_dirty_vertices;
+        mutable detail::DirtyRanges m_dirty_indices;
+        mutable IndexType m_uploaded_index_type = IndexType::UnsignedInt;
+        mutable std::vector<std::byte> m_index_buffer;
+
+        std::optional<glm::mat4> m_dequantization;
+        mutable GLint m_dequantization_program = 0;
+        mutable GLint m_dequantization_location = -1;
+
+        bool m_frozen = false;
+        std::size_t m_frozen_vertex_count = 0;
+        std::size_t m_frozen_index_count = 0;
+
+        struct StreamRing {
+            unsigned frames = 0;
+            unsigned current = 0;
+            bool persistent = false;
+            bool submitted = false;             // the current region was bound for drawing
+            std::size_t vertex_capacity = 0;    // per region
+            std::size_t index_capacity = 0;
+            std::size_t vertex_count = 0;       // written in the current region
+            std::size_t index_count = 0;
+            Buffer<std::byte> vertex_buffer;
+            Buffer<std::byte> index_buffer;
+            std::byte* vertices = nullptr;      // persistent mapping of the whole ring
+            std::byte* indices = nullptr;
+            std::byte* region_vertices = nullptr;   // current region, while mapped
+            unsigned* region_indices = nullptr;
+            std::vector<GLsync> fences;
+            GLsync copy_fence = nullptr;        // the geometry copied when growing, before it may be written over
+        };
+        mutable StreamRing m_stream;
+    };
+
+    template <typename... AttrTypes>
+    template <typename... InstanceTypes>
+    class VertexArray<AttrTypes...>::Instances : public VertexArray<AttrTypes...> {
+        using InstanceTuple = std::tuple<InstanceTypes...>;
+        using InstanceLayout = detail::VertexLayout<InstanceTypes...>;
+
+    public:
+        explicit Instances(Primitive primitive_type = Primitive::Triangles);
+
+        void clearInstances();
+
+        void pushInstance(const InstanceTuple& instance);
+        void updateInstance(std::size_t index, const InstanceTuple& instance);
+
+        template <detail::convertible_to_tuple<InstanceTuple> InstanceStruct>
+        void pushInstance(const InstanceStruct& instance) {
+            pushInstances(std::span<const InstanceStruct>(&instance, 1));
+        }
+
+        template <typename InstanceStruct>
+            requires std::same_as<InstanceStruct, InstanceTuple> || detail::convertible_to_tuple<InstanceStruct, InstanceTuple>
+        void pushInstances(std::span<const InstanceStruct> instances) {
+            const auto first = getInstanceCount();
+            m_instances.resize((first + instances.size()) * InstanceLayout::stride);
+            InstanceLayout::storeRange(m_instances.data() + first * InstanceLayout::stride, instances);
+            m_dirty_instances.add(first, first + instances.size());
+        }
+
+        [[nodiscard]] auto getInstanceCount() const -> std::size_t { return m_instances.size() / InstanceLayout::stride; }
+
+        void bind() const override;
+
+        // draws the mesh once per pushed instance, or for the first `count` instances
+        void renderInstanced() const;
+        void renderInstanced(std::size_t count) const;
+
+    private:
+        static constexpr auto inputs = [] {
+            constexpr auto vertex = detail::vertex_input_descs<AttrTypes...>();
+            constexpr auto instance = detail::vertex_input_descs<InstanceTypes...>(vertex_locations);
+            auto result = std::array<detail::VertexInputDesc, vertex.size() + instance.size()>{};
+            std::copy(vertex.begin(), vertex.end(), result.begin());
+            std::copy(instance.begin(), instance.end(), result.begin() + vertex.size());
+            return result;
+        }();
+
+        mutable Buffer<std::byte> m_instance_vbo;
+
+        std::vector<std::byte> m_instances;
+
+        mutable detail::DirtyRanges m_dirty_instances;
     };
 }
 
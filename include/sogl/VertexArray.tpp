@@ -9,133 +9,689 @@ namespace sogl {
         create();
     }
 
+    template <typename... AttrTypes>
+    VertexArray<AttrTypes...>::~VertexArray() {
+        releaseStreamRing();
+        GlState::current().deleteVertexArray(m_vao);
+    }
+
+    template <typename... AttrTypes>
+    VertexArray<AttrTypes...>::VertexArray(VertexArray&& other) noexcept :
+    m_primitive_type(other.m_primitive_type),
+    m_index_type(other.m_index_type),
+    m_vao(std::exchange(other.m_vao, 0)),
+    m_vbo(std::move(other.m_vbo)),
+    m_ibo(std::move(other.m_ibo)),
+    m_inputs(other.m_inputs),
+    m_vertices(std::move(other.m_vertices)),
+    m_indices(std::move(other.m_indices)),
+    m_dirty(other.m_dirty),
+    m_dirty_vertices(std::move(other.m_dirty_vertices)),
+    m_dirty_indices(std::move(other.m_dirty_indices)),
+    m_uploaded_index_type(other.m_uploaded_index_type),
+    m_index_buffer(std::move(other.m_index_buffer)),
+    m_dequantization(other.m_dequantization),
+    m_dequantization_program(other.m_dequantization_program),
+    m_dequantization_location(other.m_dequantization_location),
+    m_frozen(std::exchange(other.m_frozen, false)),
+    m_frozen_vertex_count(std::exchange(other.m_frozen_vertex_count, 0)),
+    m_frozen_index_count(std::exchange(other.m_frozen_index_count, 0)),
+    m_stream(std::exchange(other.m_stream, {})) {}
+
+    template <typename... AttrTypes>
+    auto VertexArray<AttrTypes...>::operator=(VertexArray&& other) noexcept -> VertexArray& {
+        if (this != &other) {
+            releaseStreamRing();
+            GlState::current().deleteVertexArray(m_vao);
+            m_primitive_type = other.m_primitive_type;
+            m_index_type = other.m_index_type;
+            m_vao = std::exchange(other.m_vao, 0);
+            m_vbo = std::move(other.m_vbo);
+            m_ibo = std::move(other.m_ibo);
+            m_inputs = other.m_inputs;
+            m_vertices = std::move(other.m_vertices);
+            m_indices = std::move(other.m_indices);
+            m_dirty = other.m_dirty;
+            m_dirty_vertices = std::move(other.m_dirty_vertices);
+            m_dirty_indices = std::move(other.m_dirty_indices);
+            m_uploaded_index_type = other.m_uploaded_index_type;
+            m_index_buffer = std::move(other.m_index_buffer);
+            m_dequantization = other.m_dequantization;
+            m_dequantization_program = other.m_dequantization_program;
+            m_dequantization_location = other.m_dequantization_location;
+            m_frozen = std::exchange(other.m_frozen, false);
+            m_frozen_vertex_count = std::exchange(other.m_frozen_vertex_count, 0);
+            m_frozen_index_count = std::exchange(other.m_frozen_index_count, 0);
+            m_stream = std::exchange(other.m_stream, {});
+        }
+        return *this;
+    }
+
     template <typename... AttrTypes>
     void VertexArray<AttrTypes...>::setPrimitiveType(sogl::Primitive primitive_type) {
         m_primitive_type = primitive_type;
     }
 
     template <typename... AttrTypes>
-    void VertexArray<AttrTypes...>::create() {
-        glGenVertexArrays(1, &m_vao);
-        glBindVertexArray(m_vao);
+    void VertexArray<AttrTypes...>::setIndexType(IndexType index_type) {
+        m_index_type = index_type;
+        m_dirty = true;
+    }
 
-        glGenBuffers(1, &m_vbo);
-        glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-        glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_DYNAMIC_DRAW);
+    template <typename... AttrTypes>
+    auto VertexArray<AttrTypes...>::getIndexType() const -> IndexType {
+        if (m_stream.frames > 0)
+            return IndexType::UnsignedInt;
+        return detail::select_index_type(m_index_type, getVertexCount());
+    }
 
-        enableVertexAttribs<0, AttrTypes...>();
+    template <typename... AttrTypes>
+    void VertexArray<AttrTypes...>::setStreaming(unsigned frames_in_flight) {
+        assert(!m_frozen);
+#if !defined(EMSCRIPTEN)
+        // the geometry moves between the CPU copy and the ring
+        if (m_stream.frames > 0) {
+            readStream();
+        }
+        releaseStreamRing();
+        m_stream.frames = frames_in_flight;
+        m_stream.persistent = GLEW_ARB_buffer_storage;
 
-        glGenBuffers(1, &m_ibo);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ibo);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, 0, nullptr, GL_DYNAMIC_DRAW);
+        if (frames_in_flight == 0) {
+            // go back to the regular buffers, they were not kept up to date while streaming
+            attachBuffers();
+            m_dirty_vertices.add(0, getVertexCount());
+            m_dirty_indices.add(0, m_indices.size());
+            m_dirty = true;
+            return;
+        }
+
+        const auto vertices = std::move(m_vertices);
+        const auto indices = std::move(m_indices);
+        m_vertices.clear();
+        m_indices.clear();
+        m_dirty_vertices.clear();
+        m_dirty_indices.clear();
+        if (!vertices.empty()) {
+            std::memcpy(allocateVertices(vertices.size() / Layout::stride), vertices.data(), vertices.size());
+        }
+        if (!indices.empty()) {
+            std::copy(indices.begin(), indices.end(), allocateIndices(indices.size()));
+        }
+#endif
+    }
+
+    template <typename... AttrTypes>
+    void VertexArray<AttrTypes...>::freeze() {
+        if (m_frozen)
+            return;
+
+#if !defined(EMSCRIPTEN)
+        if (m_stream.frames > 0) {
+            readStream();
+            releaseStreamRing();
+            m_stream.frames = 0;
+        }
+#endif
+        const auto index_type = getIndexType();
+        m_index_buffer.resize(m_indices.size() * detail::index_size(index_type));
+        detail::pack_indices(index_type, m_indices.data(), m_indices.size(), m_index_buffer.data());
+
+        // immutable storage can't be respecified, it goes in new buffers
+        detail::upload_static(m_vbo, m_vertices);
+        detail::upload_static(m_ibo, m_index_buffer);
+        attachBuffers();
+
+        m_frozen_vertex_count = getVertexCount();
+        m_frozen_index_count = m_indices.size();
+        m_uploaded_index_type = index_type;
+        m_frozen = true;
+
+        // the GPU now holds the only copy of the geometry
+        std::vector<std::byte>().swap(m_vertices);
+        std::vector<unsigned>().swap(m_indices);
+        std::vector<std::byte>().swap(m_index_buffer);
+        m_dirty_vertices.clear();
+        m_dirty_indices.clear();
+        m_dirty = false;
+    }
+
+    template <typename... AttrTypes>
+    auto VertexArray<AttrTypes...>::optimize(unsigned cache_size) -> MeshOptimizationReport {
+        assert(!m_frozen && m_stream.frames == 0);
+        if (m_primitive_type != Primitive::Triangles) {
+            const auto vertex_count = getVertexCount();
+            return {vertex_count, vertex_count, 0.f, 0.f};
+        }
+
+        auto report = detail::optimize_mesh(m_vertices, Layout::stride, m_indices, cache_size);
+
+        m_dirty_vertices.clear();
+        m_dirty_vertices.add(0, getVertexCount());
+        m_dirty_indices.clear();
+        m_dirty_indices.add(0, m_indices.size());
+        m_dirty = true;
+        return report;
+    }
+
+    template <typename... AttrTypes>
+    void VertexArray<AttrTypes...>::setDequantization(const glm::mat4& dequantization) {
+        m_dequantization = dequantization;
+    }
+
+    template <typename... AttrTypes>
+    void VertexArray<AttrTypes...>::attachBuffers() const {
+        GlState::current().bindVertexArray(m_vao);
+        m_vbo.bind(BufferTarget::Vertex);
+        detail::enable_vertex_attribs<Layout, 0, AttrTypes...>();
+        m_ibo.bind(BufferTarget::Index);
+    }
+
+    template <typename... AttrTypes>
+    void VertexArray<AttrTypes...>::create() {
+        glGenVertexArrays(1, &m_vao);
+        m_vbo.create(0, BufferUsage::DynamicDraw);
+        m_ibo.create(0, BufferUsage::DynamicDraw);
+        attachBuffers();
     }
 
     template <typename... AttrTypes>
     void VertexArray<AttrTypes...>::clear() {
+#if !defined(EMSCRIPTEN)
+        if (m_stream.frames > 0) {
+            nextStreamRegion();
+            return;
+        }
+#endif
+        if (m_frozen) {
+            // back to regular buffers that can be reallocated
+            m_vbo.create(0, BufferUsage::DynamicDraw);
+            m_ibo.create(0, BufferUsage::DynamicDraw);
+            attachBuffers();
+            m_frozen = false;
+            m_frozen_vertex_count = 0;
+            m_frozen_index_count = 0;
+        }
         m_vertices.clear();
         m_indices.clear();
-        m_buffer.clear();
+        m_dirty_vertices.clear();
+        m_dirty_indices.clear();
         m_dirty = true;
     }
 
     template <typename... AttrTypes>
-    template <unsigned I, typename AttribT, typename... AttribTs>
-    void VertexArray<AttrTypes...>::enableVertexAttribs(size_t offset) {
-        const auto components_nb = sizeof(AttribT) / sizeof(float);
+    void VertexArray<AttrTypes...>::push(const VertexTuple& v) {
+        pushPrimitive(std::array<VertexTuple, 1>{v}, {0});
+    }
 
-        glEnableVertexAttribArray(I);
-        glVertexAttribPointer(I, components_nb, GL_FLOAT, GL_FALSE, sizeof(VertexTuple), (void*) offset);
+    template <typename... AttrTypes>
+    void VertexArray<AttrTypes...>::pushTriangle(const std::array<VertexTuple, 3>& vertices) {
+        pushPrimitive(vertices, {0, 1, 2});
+    }
+
+    template <typename... AttrTypes>
+    void VertexArray<AttrTypes...>::pushQuad(const std::array<VertexTuple, 4>& vertices) {
+        pushPrimitive(vertices, {0, 1, 2, 0, 2, 3});
+    }
+
+    template <typename... AttrTypes>
+    template <typename VertexStruct, std::size_t N>
+    void VertexArray<AttrTypes...>::pushPrimitive(const std::array<VertexStruct, N>& vertices,
+                                                  std::initializer_list<unsigned> indices) {
+        const auto base_vertex = static_cast<unsigned>(getVertexCount());
+        Layout::storeRange(allocateVertices(N), std::span<const VertexStruct>(vertices));
 
-        if constexpr (I < sizeof...(AttrTypes) - 1) {
-            enableVertexAttribs<I + 1, AttribTs...>(offset + sizeof(AttribT));
+        auto* dst = allocateIndices(indices.size());
+        for (auto index : indices) {
+            *dst++ = base_vertex + index;
         }
     }
 
     template <typename... AttrTypes>
-    void VertexArray<AttrTypes...>::push(const VertexTuple& v) {
-        m_indices.push_back(m_vertices.size());
-        m_vertices.push_back(v);
+    auto VertexArray<AttrTypes...>::allocateVertices(std::size_t count) -> std::byte* {
+        assert(!m_frozen);
+#if !defined(EMSCRIPTEN)
+        if (m_stream.frames > 0) {
+            reserveStream(m_stream.vertex_count + count, m_stream.index_count);
+            mapStreamRegion();
+            auto* vertices = m_stream.region_vertices + m_stream.vertex_count * Layout::stride;
+            m_stream.vertex_count += count;
+            return vertices;
+        }
+#endif
+        const auto first = getVertexCount();
+        m_vertices.resize((first + count) * Layout::stride);
 
+        m_dirty_vertices.add(first, first + count);
         m_dirty = true;
+
+        return m_vertices.data() + first * Layout::stride;
     }
 
     template <typename... AttrTypes>
-    void VertexArray<AttrTypes...>::pushTriangle(const std::array<VertexTuple, 3>& vertices) {
-        auto index_offset = m_vertices.size();
-
-        for (const auto& v : vertices) {
-            m_vertices.push_back(v);
+    auto VertexArray<AttrTypes...>::allocateIndices(std::size_t count) -> unsigned* {
+        assert(!m_frozen);
+#if !defined(EMSCRIPTEN)
+        if (m_stream.frames > 0) {
+            reserveStream(m_stream.vertex_count, m_stream.index_count + count);
+            mapStreamRegion();
+            auto* indices = m_stream.region_indices + m_stream.index_count;
+            m_stream.index_count += count;
+            return indices;
         }
+#endif
+        const auto first = m_indices.size();
+        m_indices.resize(first + count);
 
-        m_indices.push_back(index_offset);
-        m_indices.push_back(index_offset + 1);
-        m_indices.push_back(index_offset + 2);
-
+        m_dirty_indices.add(first, first + count);
         m_dirty = true;
+
+        return m_indices.data() + first;
     }
 
     template <typename... AttrTypes>
-    void VertexArray<AttrTypes...>::pushQuad(const std::array<VertexTuple, 4>& vertices) {
-        auto index_offset = m_vertices.size();
+    auto VertexArray<AttrTypes...>::emplace(std::size_t vertex_count, std::size_t index_count) -> Writer {
+        const auto base_vertex = static_cast<unsigned>(getVertexCount());
+        auto* vertices = allocateVertices(vertex_count);
+        auto* indices = allocateIndices(index_count);
+        return {vertices, indices, base_vertex};
+    }
 
-        for (const auto& v : vertices) {
-            m_vertices.push_back(v);
+    template <typename... AttrTypes>
+    void VertexArray<AttrTypes...>::reserve(std::size_t vertex_count, std::size_t index_count) {
+#if !defined(EMSCRIPTEN)
+        if (m_stream.frames > 0) {
+            reserveStream(vertex_count, index_count);
+            return;
         }
+#endif
+        m_vertices.reserve(vertex_count * Layout::stride);
+        m_indices.reserve(index_count);
+    }
 
-        m_indices.push_back(index_offset);
-        m_indices.push_back(index_offset + 1);
-        m_indices.push_back(index_offset + 2);
-        m_indices.push_back(index_offset);
-        m_indices.push_back(index_offset + 2);
-        m_indices.push_back(index_offset + 3);
+    template <typename... AttrTypes>
+    void VertexArray<AttrTypes...>::update(std::size_t index, const VertexTuple& v) {
+        Layout::write(editVertices(index, 1), v);
+    }
 
+    template <typename... AttrTypes>
+    void VertexArray<AttrTypes...>::updateRange(std::size_t first, std::span<const VertexTuple> vertices) {
+        Layout::storeRange(editVertices(first, vertices.size()), vertices);
+    }
+
+    template <typename... AttrTypes>
+    auto VertexArray<AttrTypes...>::editVertices(std::size_t first, std::size_t count) -> std::byte* {
+        assert(!m_frozen && first + count <= getVertexCount());
+#if !defined(EMSCRIPTEN)
+        if (m_stream.frames > 0) {
+            // the vertices may have been copied there by the GPU when the ring grew
+            if (m_stream.copy_fence != nullptr) {
+                while (glClientWaitSync(m_stream.copy_fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000) == GL_TIMEOUT_EXPIRED) {}
+                glDeleteSync(m_stream.copy_fence);
+                m_stream.copy_fence = nullptr;
+            }
+            mapStreamRegion();
+            return m_stream.region_vertices + first * Layout::stride;
+        }
+#endif
+        m_dirty_vertices.add(first, first + count);
         m_dirty = true;
+        return m_vertices.data() + first * Layout::stride;
     }
 
     template <typename... AttrTypes>
     void VertexArray<AttrTypes...>::bind() const {
-        if (m_dirty) {
+        if (m_stream.frames > 0) {
+            // the geometry is already in the ring, the region only needs to be unmapped before drawing
+            unmapStreamRegion();
+            m_stream.submitted = m_stream.vertex_capacity > 0;
+        } else if (m_dirty && !m_frozen) {
+            uploadRanges();
+            m_dirty = false;
+        }
+        GlState::current().bindVertexArray(m_vao);
+        if (m_stream.frames > 0) {
+            m_stream.index_buffer.bind(BufferTarget::Index);
+        } else {
+            m_ibo.bind(BufferTarget::Index);
+        }
+
+        if (m_dequantization) {
+            // the location is looked up again only when another program is in use
+            const auto program = static_cast<GLint>(GlState::current().getProgram());
+            if (program != m_dequantization_program) {
+                m_dequantization_program = program;
+                m_dequantization_location = detail::uniform_location(program, "dequantize");
+            }
+            if (m_dequantization_location >= 0) {
+                glUniformMatrix4fv(m_dequantization_location, 1, GL_FALSE, &(*m_dequantization)[0][0]);
+            }
+        }
+    }
+
+    template <typename... AttrTypes>
+    void VertexArray<AttrTypes...>::uploadRanges() const {
+        detail::upload_ranges(m_vbo, m_vertices, Layout::stride, m_dirty_vertices);
 
-            m_buffer.clear();
-            m_buffer.reserve(m_vertices.size() * sizeof(typename decltype(m_vertices)::value_type));
-            for (const auto& vert : m_vertices) {
-                pushVertexToBuffer(m_buffer, vert);
+        // the whole index buffer is converted again when the index type changes
+        const auto index_type = getIndexType();
+        const auto index_size = detail::index_size(index_type);
+        const auto index_bytes = m_indices.size() * index_size;
+        if (index_type != m_uploaded_index_type) {
+            m_uploaded_index_type = index_type;
+            m_dirty_indices.clear();
+            m_dirty_indices.add(0, m_indices.size());
+        }
+        if (index_bytes > m_ibo.getSize()) {
+            m_ibo.create(std::max(index_bytes, m_ibo.getSize() * 2), BufferUsage::DynamicDraw);
+            m_dirty_indices.clear();
+            m_dirty_indices.add(0, m_indices.size());
+        }
+        for (auto [first, last] : m_dirty_indices) {
+            last = std::min(last, m_indices.size());
+            if (first >= last)
+                continue;
+
+            if (index_type == IndexType::UnsignedInt) {
+                m_ibo.update(std::as_bytes(std::span(m_indices).subspan(first, last - first)), first * index_size);
+            } else {
+                m_index_buffer.resize((last - first) * index_size);
+                detail::pack_indices(index_type, m_indices.data() + first, last - first, m_index_buffer.data());
+                m_ibo.update(m_index_buffer, first * index_size);
             }
+        }
+
+        m_dirty_indices.clear();
+    }
 
-            glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-            glBufferData(GL_ARRAY_BUFFER, m_buffer.size() * sizeof(typename decltype(m_buffer)::value_type),
-                         m_buffer.data(), GL_DYNAMIC_DRAW);
-            glBindBuffer(GL_ARRAY_BUFFER, 0);
+    template <typename... AttrTypes>
+    void VertexArray<AttrTypes...>::reserveStream(std::size_t vertex_count, std::size_t index_count) {
+#if !defined(EMSCRIPTEN)
+        auto& ring = m_stream;
+        if (vertex_count <= ring.vertex_capacity && index_count <= ring.index_capacity)
+            return;
 
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ibo);
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_indices.size() * sizeof(typename decltype(m_indices)::value_type),
-                         const_cast<unsigned*>(m_indices.data()), GL_DYNAMIC_DRAW);
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        // the current frame moves to the first region of the new ring, the GPU copies it while
+        // the old buffers stay alive for the draws already issued
+        unmapStreamRegion();
+        const auto old_vertices = std::move(ring.vertex_buffer);
+        const auto old_indices = std::move(ring.index_buffer);
+        const auto first_vertex = ring.current * ring.vertex_capacity;
+        const auto first_index = ring.current * ring.index_capacity;
+        const auto written_vertices = ring.vertex_count;
+        const auto written_indices = ring.index_count;
 
-            m_dirty = false;
+        // grow geometrically so that a slowly growing mesh does not reallocate every frame
+        constexpr auto min_capacity = std::size_t(1024);
+        allocateStreamRing(std::max({vertex_count, ring.vertex_capacity * 2, min_capacity}),
+                           std::max({index_count, ring.index_capacity * 2, min_capacity}));
+
+        ring.vertex_count = written_vertices;
+        ring.index_count = written_indices;
+        if (written_vertices > 0 || written_indices > 0) {
+            old_vertices.copyTo(ring.vertex_buffer, first_vertex * Layout::stride, 0, written_vertices * Layout::stride);
+            old_indices.copyTo(ring.index_buffer, first_index * sizeof(unsigned), 0, written_indices * sizeof(unsigned));
+            ring.copy_fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
         }
-        glBindVertexArray(m_vao);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ibo);
+#endif
     }
 
     template <typename... AttrTypes>
-    template <unsigned I>
-    void VertexArray<AttrTypes...>::pushVertexToBuffer(std::vector<float>& vec, const VertexTuple& vert) const {
-        auto& data = std::get<I>(vert);
-        auto size = sizeof(data) / sizeof(float);
-        const auto* raw = reinterpret_cast<const float*>(&data);
-        for (size_t i = 0; i < size; ++i)
-            vec.push_back(raw[i]);
+    void VertexArray<AttrTypes...>::allocateStreamRing(std::size_t vertex_capacity, std::size_t index_capacity) {
+#if !defined(EMSCRIPTEN)
+        releaseStreamRing();
+
+        auto& ring = m_stream;
+        ring.vertex_capacity = vertex_capacity;
+        ring.index_capacity = index_capacity;
+        ring.fences.assign(ring.frames, nullptr);
+
+        const auto vertex_bytes = ring.frames * vertex_capacity * Layout::stride;
+        const auto index_bytes = ring.frames * index_capacity * sizeof(unsigned);
+        const auto storage = BufferStorage::Write | BufferStorage::Persistent | BufferStorage::Coherent;
+        const auto access = BufferAccess::Write | BufferAccess::Persistent | BufferAccess::Coherent;
 
-        if constexpr(I < sizeof...(AttrTypes) - 1) {
-            pushVertexToBuffer<I+1>(vec, vert);
+        if (ring.persistent) {
+            ring.vertex_buffer.create(vertex_bytes, storage);
+            ring.vertices = ring.vertex_buffer.map(access).data();
+            ring.index_buffer.create(index_bytes, storage);
+            ring.indices = ring.index_buffer.map(access).data();
+        } else {
+            ring.vertex_buffer.create(vertex_bytes, BufferUsage::StreamDraw);
+            ring.index_buffer.create(index_bytes, BufferUsage::StreamDraw);
         }
+
+        GlState::current().bindVertexArray(m_vao);
+        ring.vertex_buffer.bind(BufferTarget::Vertex);
+        detail::enable_vertex_attribs<Layout, 0, AttrTypes...>();
+        ring.index_buffer.bind(BufferTarget::Index);
+#endif
+    }
+
+    template <typename... AttrTypes>
+    void VertexArray<AttrTypes...>::releaseStreamRing() {
+#if !defined(EMSCRIPTEN)
+        auto& ring = m_stream;
+        for (auto& fence : ring.fences) {
+            if (fence != nullptr) {
+                glDeleteSync(fence);
+            }
+        }
+        ring.fences.clear();
+        if (ring.copy_fence != nullptr) {
+            glDeleteSync(ring.copy_fence);
+            ring.copy_fence = nullptr;
+        }
+
+        // the driver keeps the storage alive until the gpu is done with it
+        ring.vertex_buffer.destroy();
+        ring.index_buffer.destroy();
+        ring.vertices = nullptr;
+        ring.indices = nullptr;
+        ring.region_vertices = nullptr;
+        ring.region_indices = nullptr;
+        ring.vertex_capacity = 0;
+        ring.index_capacity = 0;
+        ring.vertex_count = 0;
+        ring.index_count = 0;
+        ring.current = 0;
+        ring.submitted = false;
+#endif
+    }
+
+    template <typename... AttrTypes>
+    void VertexArray<AttrTypes...>::mapStreamRegion() {
+#if !defined(EMSCRIPTEN)
+        auto& ring = m_stream;
+        if (ring.region_vertices != nullptr || ring.vertex_capacity == 0)
+            return;
+
+        // wait for the GPU to be done with the draws of the last cycle in this region
+        auto& fence = ring.fences[ring.current];
+        if (fence != nullptr) {
+            while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000) == GL_TIMEOUT_EXPIRED) {}
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+
+        const auto vertex_offset = ring.current * ring.vertex_capacity * Layout::stride;
+        const auto index_offset = ring.current * ring.index_capacity * sizeof(unsigned);
+        if (ring.persistent) {
+            ring.region_vertices = ring.vertices + vertex_offset;
+            ring.region_indices = reinterpret_cast<unsigned*>(ring.indices + index_offset);
+            return;
+        }
+
+        // a fresh region is invalidated, and the whole ring is orphaned when wrapping around.
+        // a region mapped again after a bind keeps what was written before
+        auto access = BufferAccess::Write | BufferAccess::Unsynchronized;
+        if (ring.vertex_count == 0 && ring.index_count == 0) {
+            if (ring.current == 0) {
+                ring.vertex_buffer.invalidate();
+                ring.index_buffer.invalidate();
+            }
+            access = access | BufferAccess::InvalidateRange;
+        }
+        ring.region_vertices = ring.vertex_buffer.mapRange(vertex_offset, ring.vertex_capacity * Layout::stride, access).data();
+        ring.region_indices = reinterpret_cast<unsigned*>(
+            ring.index_buffer.mapRange(index_offset, ring.index_capacity * sizeof(unsigned), access).data());
+#endif
+    }
+
+    template <typename... AttrTypes>
+    void VertexArray<AttrTypes...>::unmapStreamRegion() const {
+#if !defined(EMSCRIPTEN)
+        auto& ring = m_stream;
+        if (ring.persistent || ring.region_vertices == nullptr)
+            return;
+
+        ring.vertex_buffer.unmap();
+        ring.index_buffer.unmap();
+        ring.region_vertices = nullptr;
+        ring.region_indices = nullptr;
+#endif
+    }
+
+    template <typename... AttrTypes>
+    void VertexArray<AttrTypes...>::nextStreamRegion() {
+#if !defined(EMSCRIPTEN)
+        auto& ring = m_stream;
+        if (ring.submitted) {
+            unmapStreamRegion();
+            if (ring.persistent) {
+                ring.fences[ring.current] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            }
+            ring.current = (ring.current + 1) % ring.frames;
+            ring.region_vertices = nullptr;
+            ring.region_indices = nullptr;
+            ring.submitted = false;
+        }
+        // a region that was never drawn from is written again
+        ring.vertex_count = 0;
+        ring.index_count = 0;
+#endif
+    }
+
+    template <typename... AttrTypes>
+    void VertexArray<AttrTypes...>::readStream() {
+#if !defined(EMSCRIPTEN)
+        auto& ring = m_stream;
+        m_vertices.clear();
+        m_indices.clear();
+        if (ring.vertex_capacity == 0)
+            return;
+
+        // waits for the GPU, switching modes is not meant to happen every frame
+        unmapStreamRegion();
+        m_vertices = ring.vertex_buffer.read(ring.current * ring.vertex_capacity * Layout::stride,
+                                             ring.vertex_count * Layout::stride);
+        const auto indices = ring.index_buffer.read(ring.current * ring.index_capacity * sizeof(unsigned),
+                                                    ring.index_count * sizeof(unsigned));
+        m_indices.resize(ring.index_count);
+        std::memcpy(m_indices.data(), indices.data(), indices.size());
+#endif
     }
 
     template <typename... AttrTypes>
     void VertexArray<AttrTypes...>::render() const {
-        glDrawElements(static_cast<std::underlying_type_t<Primitive>>(m_primitive_type),
-                       m_indices.size(), GL_UNSIGNED_INT, nullptr);
+        draw(0, getIndexCount(), 0);
+    }
+
+    template <typename... AttrTypes>
+    void VertexArray<AttrTypes...>::renderRange(std::size_t first_index, std::size_t index_count) const {
+        draw(first_index, index_count, 0);
+    }
+
+    template <typename... AttrTypes>
+    void VertexArray<AttrTypes...>::draw(std::size_t first_index, std::size_t index_count, std::size_t instance_count) const {
+#if !defined(NDEBUG)
+        const auto program = GlState::current().getProgram();
+        detail::check_vertex_inputs(program, m_inputs);
+        if (program == 0) {
+            detail::check_program_pipeline(GlState::current().getProgramPipeline());
+        }
+#endif
+        const auto mode = static_cast<std::underlying_type_t<Primitive>>(m_primitive_type);
+        const auto count = static_cast<GLsizei>(index_count);
+#if !defined(EMSCRIPTEN)
+        if (m_stream.frames > 0) {
+            const auto type = static_cast<GLenum>(GL_UNSIGNED_INT);
+            const auto first = m_stream.current * m_stream.index_capacity + first_index;
+            const auto* offset = reinterpret_cast<void*>(first * sizeof(unsigned));
+            const auto base_vertex = static_cast<GLint>(m_stream.current * m_stream.vertex_capacity);
+            if (instance_count > 0) {
+                glDrawElementsInstancedBaseVertex(mode, count, type, offset, instance_count, base_vertex);
+            } else {
+                glDrawElementsBaseVertex(mode, count, type, offset, base_vertex);
+            }
+            return;
+        }
+#endif
+        const auto type = static_cast<GLenum>(m_uploaded_index_type);
+        const auto* offset = reinterpret_cast<void*>(first_index * detail::index_size(m_uploaded_index_type));
+        if (instance_count > 0) {
+            glDrawElementsInstanced(mode, count, type, offset, instance_count);
+        } else {
+            glDrawElements(mode, count, type, offset);
+        }
+    }
+
+    template <typename... AttrTypes>
+    template <typename... InstanceTypes>
+    VertexArray<AttrTypes...>::Instances<InstanceTypes...>::Instances(Primitive primitive_type)
+    : VertexArray(primitive_type) {
+        this->m_inputs = inputs;
+        m_instance_vbo.create(0, BufferUsage::DynamicDraw);
+
+        // instance attributes locations follow the vertex attributes ones
+        GlState::current().bindVertexArray(this->m_vao);
+        m_instance_vbo.bind(BufferTarget::Vertex);
+        detail::enable_vertex_attribs<InstanceLayout, 0, InstanceTypes...>(vertex_locations, 1);
+    }
+
+    template <typename... AttrTypes>
+    template <typename... InstanceTypes>
+    void VertexArray<AttrTypes...>::Instances<InstanceTypes...>::clearInstances() {
+        m_instances.clear();
+        m_dirty_instances.clear();
+    }
+
+    template <typename... AttrTypes>
+    template <typename... InstanceTypes>
+    void VertexArray<AttrTypes...>::Instances<InstanceTypes...>::pushInstance(const InstanceTuple& instance) {
+        pushInstances(std::span<const InstanceTuple>(&instance, 1));
+    }
+
+    template <typename... AttrTypes>
+    template <typename... InstanceTypes>
+    void VertexArray<AttrTypes...>::Instances<InstanceTypes...>::updateInstance(std::size_t index,
+                                                                               const InstanceTuple& instance) {
+        InstanceLayout::write(m_instances.data() + index * InstanceLayout::stride, instance);
+        m_dirty_instances.add(index, index + 1);
+    }
+
+    template <typename... AttrTypes>
+    template <typename... InstanceTypes>
+    void VertexArray<AttrTypes...>::Instances<InstanceTypes...>::bind() const {
+        VertexArray::bind();
+
+        if (!m_dirty_instances.empty()) {
+            detail::upload_ranges(m_instance_vbo, m_instances, InstanceLayout::stride, m_dirty_instances);
+        }
+    }
+
+    template <typename... AttrTypes>
+    template <typename... InstanceTypes>
+    void VertexArray<AttrTypes...>::Instances<InstanceTypes...>::renderInstanced() const {
+        renderInstanced(getInstanceCount());
+    }
+
+    template <typename... AttrTypes>
+    template <typename... InstanceTypes>
+    void VertexArray<AttrTypes...>::Instances<InstanceTypes...>::renderInstanced(std::size_t count) const {
+        if (count > 0) {
+            this->draw(0, this->getIndexCount(), count);
+        }
     }
 
 }
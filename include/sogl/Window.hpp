@@ -3,6 +3,7 @@
 #pragma once
 
 #include <sogl/Event.hpp>
+#include <sogl/GlState.hpp>
 
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
@@ -45,6 +46,7 @@ namespace sogl {
         glm::vec<2, int> m_size;
         std::queue<Event> m_events;
         std::chrono::time_point<std::chrono::high_resolution_clock> m_frame_time;
+        GlState m_gl_state;
     };
 
 }
@@ -2,12 +2,24 @@
 
 #pragma once
 
+#include <sogl/Buffer.hpp>
 #include <sogl/Event.hpp>
 #include <sogl/Font.hpp>
 #include <sogl/FrameBuffer.hpp>
+#include <sogl/GlState.hpp>
+#include <sogl/MeshPool.hpp>
 #include <sogl/PostProcess.hpp>
+#include <sogl/RenderQueue.hpp>
 #include <sogl/Shader.hpp>
+#include <sogl/ShaderBatch.hpp>
+#include <sogl/ShaderLibrary.hpp>
+#include <sogl/ShaderPipeline.hpp>
+#include <sogl/ShaderReflection.hpp>
+#include <sogl/SpriteBatch.hpp>
+#include <sogl/StorageBuffer.hpp>
+#include <sogl/TextBatch.hpp>
 #include <sogl/Texture.hpp>
+#include <sogl/UniformBuffer.hpp>
 #include <sogl/VertexArray.hpp>
 #include <sogl/Window.hpp>
 
@@ -0,0 +1,91 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#include <sogl/Buffer.hpp>
+
+#include <algorithm>
+
+using namespace sogl;
+using namespace sogl::detail;
+
+RangeAllocator::RangeAllocator(std::size_t capacity) : m_capacity(capacity) {
+    if (capacity > 0)
+        m_free.emplace_back(0, capacity);
+}
+
+auto RangeAllocator::allocate(std::size_t size) -> std::optional<std::size_t> {
+    if (size == 0)
+        return 0;
+
+    auto it = std::find_if(m_free.begin(), m_free.end(), [&](const auto& block) { return block.second >= size; });
+    if (it == m_free.end())
+        return std::nullopt;
+
+    const auto offset = it->first;
+    if (it->second == size) {
+        m_free.erase(it);
+    } else {
+        it->first += size;
+        it->second -= size;
+    }
+    return offset;
+}
+
+void RangeAllocator::free(std::size_t offset, std::size_t size) {
+    if (size == 0)
+        return;
+
+    auto it = std::lower_bound(m_free.begin(), m_free.end(), offset,
+                               [](const auto& block, std::size_t value) { return block.first < value; });
+    it = m_free.insert(it, {offset, size});
+
+    // merge with the next block, then with the previous one
+    if (auto next = std::next(it); next != m_free.end() && it->first + it->second == next->first) {
+        it->second += next->second;
+        m_free.erase(next);
+    }
+    if (it != m_free.begin()) {
+        if (auto prev = std::prev(it); prev->first + prev->second == it->first) {
+            prev->second += it->second;
+            m_free.erase(it);
+        }
+    }
+}
+
+void RangeAllocator::grow(std::size_t capacity) {
+    if (capacity <= m_capacity)
+        return;
+
+    const auto old_capacity = m_capacity;
+    m_capacity = capacity;
+    free(old_capacity, capacity - old_capacity);
+}
+
+void RangeAllocator::reset() {
+    m_free.clear();
+    if (m_capacity > 0)
+        m_free.emplace_back(0, m_capacity);
+}
+
+auto RangeAllocator::getCapacity() const -> std::size_t {
+    return m_capacity;
+}
+
+auto detail::buffer_storage_supported() -> bool {
+#if !defined(EMSCRIPTEN)
+    return GLEW_ARB_buffer_storage;
+#else
+    return false;
+#endif
+}
+
+auto sogl::operator|(const BufferAccess& left, const BufferAccess& right) -> BufferAccess {
+    return BufferAccess(static_cast<std::underlying_type_t<BufferAccess>>(left) |
+                        static_cast<std::underlying_type_t<BufferAccess>>(right));
+}
+
+#if !defined(EMSCRIPTEN)
+auto sogl::operator|(const BufferStorage& left, const BufferStorage& right) -> BufferStorage {
+    return BufferStorage(static_cast<std::underlying_type_t<BufferStorage>>(left) |
+                         static_cast<std::underlying_type_t<BufferStorage>>(right));
+}
+#endif
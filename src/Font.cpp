@@ -13,6 +13,10 @@ using namespace sogl;
 
 namespace {
     FT_Library ft_library = nullptr;
+
+    void push_glyph(void* glyphs, const Glyph::Shape& shape) {
+        static_cast<std::vector<Glyph::Shape>*>(glyphs)->push_back(shape);
+    }
 }
 
 Font::~Font() {
@@ -45,7 +49,8 @@ void Font::shapeText(const std::string& string, int size, std::vector<Glyph::Sha
     hb_buffer_add_utf8(hb_buffer, string.data(), -1, 0, -1);
     hb_buffer_guess_segment_properties(hb_buffer);
 
-    shape(hb_buffer, size, glyphs);
+    glyphs.clear();
+    shape(hb_buffer, size, push_glyph, &glyphs);
 
     hb_buffer_destroy(hb_buffer);
 }
@@ -55,7 +60,8 @@ void Font::shapeText(const char8_t* string, int size, std::vector<Glyph::Shape>&
     hb_buffer_add_utf8(hb_buffer, reinterpret_cast<const char*>(string), -1, 0, -1);
     hb_buffer_guess_segment_properties(hb_buffer);
 
-    shape(hb_buffer, size, glyphs);
+    glyphs.clear();
+    shape(hb_buffer, size, push_glyph, &glyphs);
 
     hb_buffer_destroy(hb_buffer);
 }
@@ -65,7 +71,19 @@ void Font::shapeText(const std::wstring& string, int size, std::vector<Glyph::Sh
     hb_buffer_add_utf16(hb_buffer, reinterpret_cast<const uint16_t*>(string.data()), -1, 0, -1);
     hb_buffer_guess_segment_properties(hb_buffer);
 
-    shape(hb_buffer, size, glyphs);
+    glyphs.clear();
+    shape(hb_buffer, size, push_glyph, &glyphs);
+
+    hb_buffer_destroy(hb_buffer);
+}
+
+void Font::shapeUtf8(std::string_view string, int size, GlyphCallback callback, void* user_data) {
+    hb_buffer_t* hb_buffer = hb_buffer_create();
+    const auto length = static_cast<int>(string.size());
+    hb_buffer_add_utf8(hb_buffer, string.data(), length, 0, length);
+    hb_buffer_guess_segment_properties(hb_buffer);
+
+    shape(hb_buffer, size, callback, user_data);
 
     hb_buffer_destroy(hb_buffer);
 }
@@ -136,7 +154,7 @@ auto Font::getTexture(int size) const -> const Texture& {
     return m_glyphpages.at(size).texture;
 }
 
-void Font::shape(void* buffer, int size, std::vector<Glyph::Shape>& glyphs) {
+void Font::shape(void* buffer, int size, GlyphCallback callback, void* user_data) {
     auto* hb_buffer = static_cast<hb_buffer_t*>(buffer);
     auto* hb_font = static_cast<hb_font_t*>(m_font);
 
@@ -148,8 +166,6 @@ void Font::shape(void* buffer, int size, std::vector<Glyph::Shape>& glyphs) {
     hb_glyph_info_t* info = hb_buffer_get_glyph_infos(hb_buffer, nullptr);
     hb_glyph_position_t* pos = hb_buffer_get_glyph_positions(hb_buffer, nullptr);
 
-    glyphs.resize(len);
-
     double curr_x = 0.;
 
     for (unsigned int i = 0; i < len; ++i) {
@@ -167,12 +183,14 @@ void Font::shape(void* buffer, int size, std::vector<Glyph::Shape>& glyphs) {
         double tex_w = glyph.tex_size.x;
         double tex_h = glyph.tex_size.y;
 
-        glyphs[i].x = static_cast<float>(pos_x);
-        glyphs[i].y = static_cast<float>(pos_y);
-        glyphs[i].u = static_cast<float>(tex_x);
-        glyphs[i].v = static_cast<float>(tex_y);
-        glyphs[i].w = static_cast<float>(tex_w);
-        glyphs[i].h = static_cast<float>(tex_h);
+        Glyph::Shape shape;
+        shape.x = static_cast<float>(pos_x);
+        shape.y = static_cast<float>(pos_y);
+        shape.u = static_cast<float>(tex_x);
+        shape.v = static_cast<float>(tex_y);
+        shape.w = static_cast<float>(tex_w);
+        shape.h = static_cast<float>(tex_h);
+        callback(user_data, shape);
 
         curr_x += adv_x;
     }
@@ -1,6 +1,7 @@
 // Created by Modar Nasser on 26/11/2023.
 
 #include <sogl/FrameBuffer.hpp>
+#include <sogl/GlState.hpp>
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
@@ -22,12 +23,13 @@ FrameBuffer::FrameBuffer() {
         {{1.f, -1.f}, {1.f, 0.f}},
         {{-1.f, -1.f}, {0.f, 0.f}}
     }});
+    m_vertex_array.freeze();
 }
 
 FrameBuffer::~FrameBuffer() {
-    glDeleteTextures(1, &m_render_texture);
+    GlState::current().deleteTexture(m_render_texture);
     glDeleteRenderbuffers(1, &m_depth_buffer);
-    glDeleteFramebuffers(1, &m_framebuffer);
+    GlState::current().deleteFramebuffer(m_framebuffer);
 }
 
 void FrameBuffer::create(int width, int height) {
@@ -35,7 +37,7 @@ void FrameBuffer::create(int width, int height) {
     m_size.y = height;
 
     // create render texture
-    glBindTexture(GL_TEXTURE_2D, m_render_texture);
+    GlState::current().bindTexture(m_render_texture);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_size.x, m_size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -45,29 +47,26 @@ void FrameBuffer::create(int width, int height) {
     glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT, m_size.x, m_size.y);
 
     // attach render texture and depth render buffer to frame buffer
-    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    GlState::current().bindFramebuffer(m_framebuffer);
     glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, m_render_texture, 0);
     glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depth_buffer);
 
     if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
         std::cout << "ERROR::FRAMEBUFFER:: Framebuffer is not complete!" << std::endl;
 
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    GlState::current().bindFramebuffer(0);
 }
 
 void FrameBuffer::clear(const glm::vec4& color) {
-    glViewport(0, 0, m_size.x, m_size.y);
+    auto& state = GlState::current();
+    state.setViewport(0, 0, m_size.x, m_size.y);
+    state.bindFramebuffer(m_framebuffer);
     glClearColor(color.r, color.g, color.b, color.a);
-    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    glBindTexture(GL_TEXTURE_2D, 0);
-    glBindVertexArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
 void FrameBuffer::display() {
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    GlState::current().bindFramebuffer(0);
 }
 
 void FrameBuffer::render() const {
@@ -76,14 +75,15 @@ void FrameBuffer::render() const {
 
 void FrameBuffer::render(const PostProcess& post_process,
                          const std::map<std::string, float>& uniforms) const {
-    post_process.shader.bind();
-    post_process.shader.setUniform("time", static_cast<float>(glfwGetTime()));
-    post_process.shader.setUniform("resolution", glm::vec2(m_size));
+    post_process.pipeline.bind();
+    post_process.pipeline.setUniform("time", static_cast<float>(glfwGetTime()));
+    post_process.pipeline.setUniform("resolution", glm::vec2(m_size));
     for (const auto& [name, val] : uniforms) {
-        post_process.shader.setUniform(name, val);
+        post_process.pipeline.setUniform(name, val);
     }
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, m_render_texture);
+    // the screen texture goes to the unit reflection gave to texture0
+    const auto unit = post_process.pipeline.getSamplerUnit("texture0");
+    GlState::current().bindTexture(m_render_texture, unit >= 0 ? static_cast<unsigned>(unit) : 0);
     m_vertex_array.bind();
     m_vertex_array.render();
 }
@@ -0,0 +1,313 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#include <sogl/GlState.hpp>
+
+#include <GL/glew.h>
+
+using namespace sogl;
+
+namespace {
+    GlState* current_state = nullptr;
+}
+
+GlState::GlState() {
+    invalidate();
+}
+
+GlState::~GlState() {
+    if (current_state == this) {
+        current_state = nullptr;
+    }
+}
+
+auto GlState::current() -> GlState& {
+    // used before any window exists, or after the last one is gone
+    static GlState fallback;
+    return current_state != nullptr ? *current_state : fallback;
+}
+
+void GlState::makeCurrent() {
+    current_state = this;
+}
+
+void GlState::useProgram(unsigned program) {
+    if (changed(m_program, program)) {
+        glUseProgram(program);
+    }
+}
+
+void GlState::bindProgramPipeline(unsigned pipeline) {
+#if !defined(EMSCRIPTEN)
+    if (changed(m_program_pipeline, pipeline)) {
+        glBindProgramPipeline(pipeline);
+    }
+#endif
+}
+
+void GlState::bindVertexArray(unsigned vertex_array) {
+    if (changed(m_vertex_array, vertex_array)) {
+        glBindVertexArray(vertex_array);
+    }
+}
+
+void GlState::bindBuffer(unsigned target, unsigned buffer) {
+    auto* slot = bufferSlot(target);
+    if (slot == nullptr) {
+        ++m_stats.issued;
+        glBindBuffer(target, buffer);
+    } else if (changed(*slot, buffer)) {
+        glBindBuffer(target, buffer);
+    }
+}
+
+void GlState::bindBufferBase(unsigned target, unsigned index, unsigned buffer) {
+    auto& bound = m_indexed_buffers.try_emplace(static_cast<std::uint64_t>(target) << 32 | index, unknown).first->second;
+    if (changed(bound, buffer)) {
+        glBindBufferBase(target, index, buffer);
+        if (auto* slot = bufferSlot(target)) {
+            *slot = buffer;
+        }
+    }
+}
+
+void GlState::bindBufferRange(unsigned target, unsigned index, unsigned buffer, std::size_t offset, std::size_t size) {
+    m_indexed_buffers.insert_or_assign(static_cast<std::uint64_t>(target) << 32 | index, unknown);
+    ++m_stats.issued;
+    glBindBufferRange(target, index, buffer, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size));
+    if (auto* slot = bufferSlot(target)) {
+        *slot = buffer;
+    }
+}
+
+void GlState::bindTexture(unsigned texture, unsigned unit) {
+    if (unit >= max_texture_units) {
+        ++m_stats.issued;
+        glActiveTexture(GL_TEXTURE0 + unit);
+        m_active_texture = unknown;
+        ++m_stats.issued;
+        glBindTexture(GL_TEXTURE_2D, texture);
+        return;
+    }
+    if (m_textures[unit] == texture) {
+        ++m_stats.skipped;
+        return;
+    }
+    if (changed(m_active_texture, unit)) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+    }
+    m_textures[unit] = texture;
+    ++m_stats.issued;
+    glBindTexture(GL_TEXTURE_2D, texture);
+}
+
+void GlState::bindFramebuffer(unsigned framebuffer) {
+    if (changed(m_framebuffer, framebuffer)) {
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    }
+}
+
+void GlState::setViewport(int x, int y, int width, int height) {
+    const auto viewport = glm::ivec4(x, y, width, height);
+    if (viewport == m_viewport) {
+        ++m_stats.skipped;
+        return;
+    }
+    m_viewport = viewport;
+    ++m_stats.issued;
+    glViewport(x, y, width, height);
+}
+
+void GlState::setEnabled(unsigned capability, bool enabled) {
+    auto [it, inserted] = m_capabilities.try_emplace(capability, enabled);
+    if (!inserted && it->second == enabled) {
+        ++m_stats.skipped;
+        return;
+    }
+    it->second = enabled;
+    ++m_stats.issued;
+    if (enabled) {
+        glEnable(capability);
+    } else {
+        glDisable(capability);
+    }
+}
+
+auto GlState::isEnabled(unsigned capability) -> bool {
+    // only capabilities never set through the cache need a query
+    auto it = m_capabilities.find(capability);
+    if (it == m_capabilities.end()) {
+        it = m_capabilities.emplace(capability, glIsEnabled(capability) == GL_TRUE).first;
+    }
+    return it->second;
+}
+
+void GlState::setBlendFunc(unsigned source, unsigned destination) {
+    if (source == m_blend_source && destination == m_blend_destination) {
+        ++m_stats.skipped;
+        return;
+    }
+    m_blend_source = source;
+    m_blend_destination = destination;
+    ++m_stats.issued;
+    glBlendFunc(source, destination);
+}
+
+void GlState::setDepthFunc(unsigned func) {
+    if (changed(m_depth_func, func)) {
+        glDepthFunc(func);
+    }
+}
+
+void GlState::deleteProgram(unsigned program) {
+    // a program in use is only deleted once it is no longer current
+    if (m_program == program) {
+        m_program = unknown;
+    }
+    glDeleteProgram(program);
+}
+
+void GlState::deleteProgramPipeline(unsigned pipeline) {
+#if !defined(EMSCRIPTEN)
+    if (m_program_pipeline == pipeline) {
+        m_program_pipeline = 0;
+    }
+    glDeleteProgramPipelines(1, &pipeline);
+#endif
+}
+
+void GlState::deleteVertexArray(unsigned vertex_array) {
+    if (m_vertex_array == vertex_array) {
+        m_vertex_array = 0;
+    }
+    m_element_buffers.erase(vertex_array);
+    glDeleteVertexArrays(1, &vertex_array);
+}
+
+void GlState::deleteBuffer(unsigned buffer) {
+    // bindings of the context go back to 0, the attachments of other vertex arrays are kept by GL
+    // but the name may be reused, they must be bound again
+    for (auto* slot : {&m_array_buffer, &m_copy_read_buffer, &m_copy_write_buffer,
+                       &m_draw_indirect_buffer, &m_uniform_buffer, &m_shader_storage_buffer, &m_pixel_unpack_buffer}) {
+        if (*slot == buffer) {
+            *slot = 0;
+        }
+    }
+    for (auto& [binding, bound] : m_indexed_buffers) {
+        if (bound == buffer) {
+            bound = 0;
+        }
+    }
+    for (auto& [vertex_array, element_buffer] : m_element_buffers) {
+        if (element_buffer == buffer) {
+            element_buffer = vertex_array == m_vertex_array ? 0 : unknown;
+        }
+    }
+    glDeleteBuffers(1, &buffer);
+}
+
+void GlState::deleteTexture(unsigned texture) {
+    for (auto& bound : m_textures) {
+        if (bound == texture) {
+            bound = 0;
+        }
+    }
+    glDeleteTextures(1, &texture);
+}
+
+void GlState::deleteFramebuffer(unsigned framebuffer) {
+    if (m_framebuffer == framebuffer) {
+        m_framebuffer = 0;
+    }
+    glDeleteFramebuffers(1, &framebuffer);
+}
+
+auto GlState::getProgram() const -> unsigned {
+    if (m_program == unknown) {
+        GLint program = 0;
+        glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+        return static_cast<unsigned>(program);
+    }
+    return m_program;
+}
+
+auto GlState::getProgramPipeline() const -> unsigned {
+#if !defined(EMSCRIPTEN)
+    if (m_program_pipeline == unknown) {
+        GLint pipeline = 0;
+        glGetIntegerv(GL_PROGRAM_PIPELINE_BINDING, &pipeline);
+        return static_cast<unsigned>(pipeline);
+    }
+    return m_program_pipeline;
+#else
+    return 0;
+#endif
+}
+
+void GlState::invalidate() {
+    m_program = unknown;
+    m_program_pipeline = unknown;
+    m_vertex_array = unknown;
+    m_array_buffer = unknown;
+    m_copy_read_buffer = unknown;
+    m_copy_write_buffer = unknown;
+    m_draw_indirect_buffer = unknown;
+    m_uniform_buffer = unknown;
+    m_shader_storage_buffer = unknown;
+    m_pixel_unpack_buffer = unknown;
+    m_element_buffers.clear();
+    m_indexed_buffers.clear();
+    m_active_texture = unknown;
+    m_textures.fill(unknown);
+    m_framebuffer = unknown;
+    m_viewport = {-1, -1, -1, -1};
+    m_capabilities.clear();
+    m_blend_source = unknown;
+    m_blend_destination = unknown;
+    m_depth_func = unknown;
+}
+
+auto GlState::getStats() const -> const Stats& {
+    return m_stats;
+}
+
+void GlState::resetStats() {
+    m_stats = {};
+}
+
+auto GlState::changed(unsigned& cached, unsigned value) -> bool {
+    if (cached == value) {
+        ++m_stats.skipped;
+        return false;
+    }
+    cached = value;
+    ++m_stats.issued;
+    return true;
+}
+
+auto GlState::bufferSlot(unsigned target) -> unsigned* {
+    switch (target) {
+        case GL_ARRAY_BUFFER:
+            return &m_array_buffer;
+        case GL_ELEMENT_ARRAY_BUFFER:
+            // unknown until a vertex array is bound through the cache
+            if (m_vertex_array == unknown)
+                return nullptr;
+            return &m_element_buffers.try_emplace(m_vertex_array, unknown).first->second;
+        case GL_COPY_READ_BUFFER:
+            return &m_copy_read_buffer;
+        case GL_COPY_WRITE_BUFFER:
+            return &m_copy_write_buffer;
+        case GL_DRAW_INDIRECT_BUFFER:
+            return &m_draw_indirect_buffer;
+        case GL_UNIFORM_BUFFER:
+            return &m_uniform_buffer;
+        case GL_PIXEL_UNPACK_BUFFER:
+            return &m_pixel_unpack_buffer;
+#if !defined(EMSCRIPTEN)
+        case GL_SHADER_STORAGE_BUFFER:
+            return &m_shader_storage_buffer;
+#endif
+        default:
+            return nullptr;
+    }
+}
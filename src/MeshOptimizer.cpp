@@ -0,0 +1,209 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#include <sogl/MeshOptimizer.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <unordered_map>
+
+using namespace sogl;
+
+namespace {
+    constexpr auto no_vertex = std::numeric_limits<unsigned>::max();
+
+    auto hash_bytes(const std::byte* data, std::size_t size) -> std::size_t {
+        // FNV-1a
+        std::size_t hash = 14695981039346656037ull;
+        for (std::size_t i = 0; i < size; ++i) {
+            hash ^= static_cast<std::size_t>(data[i]);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    // picks the next fanning vertex among the candidates that are still in the cache, or a dead end
+    auto next_vertex(const std::vector<unsigned>& candidates, const std::vector<unsigned>& live,
+                     const std::vector<unsigned>& cache_time, unsigned time, unsigned cache_size,
+                     std::vector<unsigned>& dead_ends, unsigned& cursor) -> unsigned {
+        auto best = no_vertex;
+        auto best_priority = -1;
+        for (auto v : candidates) {
+            if (live[v] == 0)
+                continue;
+            // the vertex must still be in the cache once all its remaining triangles are emitted
+            auto priority = 0;
+            if (time - cache_time[v] + 2 * live[v] <= cache_size)
+                priority = static_cast<int>(time - cache_time[v]);
+            if (priority > best_priority) {
+                best_priority = priority;
+                best = v;
+            }
+        }
+        if (best != no_vertex)
+            return best;
+
+        while (!dead_ends.empty()) {
+            const auto v = dead_ends.back();
+            dead_ends.pop_back();
+            if (live[v] > 0)
+                return v;
+        }
+        while (cursor < live.size()) {
+            if (live[cursor] > 0)
+                return cursor;
+            ++cursor;
+        }
+        return no_vertex;
+    }
+}
+
+auto detail::deduplicate_vertices(std::vector<std::byte>& vertices, std::size_t stride,
+                                  std::vector<unsigned>& indices) -> std::size_t {
+    const auto vertex_count = vertices.size() / stride;
+    const auto* data = vertices.data();
+
+    auto hash = [&](unsigned v) { return hash_bytes(data + v * stride, stride); };
+    auto equal = [&](unsigned a, unsigned b) { return std::memcmp(data + a * stride, data + b * stride, stride) == 0; };
+    std::unordered_map<unsigned, unsigned, decltype(hash), decltype(equal)> unique(vertex_count, hash, equal);
+
+    // remap[v] is the first vertex identical to v, unique vertices are compacted in place
+    std::vector<unsigned> remap(vertex_count);
+    unsigned unique_count = 0;
+    for (unsigned v = 0; v < vertex_count; ++v) {
+        auto [it, inserted] = unique.try_emplace(v, unique_count);
+        if (inserted)
+            ++unique_count;
+        remap[v] = it->second;
+    }
+
+    // the map hashes the vertex data, it must not outlive the compaction
+    unique.clear();
+    for (unsigned v = 0, next = 0; v < vertex_count; ++v) {
+        if (remap[v] == next) {
+            if (next != v)
+                std::memcpy(vertices.data() + next * stride, vertices.data() + v * stride, stride);
+            ++next;
+        }
+    }
+    vertices.resize(unique_count * stride);
+
+    for (auto& index : indices) {
+        index = remap[index];
+    }
+    return unique_count;
+}
+
+void detail::optimize_vertex_cache(std::vector<unsigned>& indices, std::size_t vertex_count, unsigned cache_size) {
+    const auto triangle_count = indices.size() / 3;
+    if (triangle_count == 0)
+        return;
+
+    // triangles using each vertex
+    std::vector<unsigned> live(vertex_count, 0);
+    for (std::size_t i = 0; i < triangle_count * 3; ++i) {
+        ++live[indices[i]];
+    }
+    std::vector<unsigned> offsets(vertex_count + 1, 0);
+    for (std::size_t v = 0; v < vertex_count; ++v) {
+        offsets[v + 1] = offsets[v] + live[v];
+    }
+    std::vector<unsigned> adjacency(triangle_count * 3);
+    {
+        auto fill = offsets;
+        for (std::size_t i = 0; i < triangle_count * 3; ++i) {
+            adjacency[fill[indices[i]]++] = static_cast<unsigned>(i / 3);
+        }
+    }
+
+    std::vector<unsigned> cache_time(vertex_count, 0);
+    std::vector<bool> emitted(triangle_count, false);
+    std::vector<unsigned> dead_ends;
+    std::vector<unsigned> candidates;
+    std::vector<unsigned> output;
+    output.reserve(triangle_count * 3);
+
+    auto time = cache_size + 1;
+    unsigned cursor = 0;
+    unsigned fanning = indices[0];
+    while (fanning != no_vertex) {
+        candidates.clear();
+        for (auto i = offsets[fanning]; i < offsets[fanning + 1]; ++i) {
+            const auto t = adjacency[i];
+            if (emitted[t])
+                continue;
+
+            for (std::size_t k = 0; k < 3; ++k) {
+                const auto v = indices[t * 3 + k];
+                output.push_back(v);
+                dead_ends.push_back(v);
+                candidates.push_back(v);
+                --live[v];
+                if (time - cache_time[v] > cache_size) {
+                    cache_time[v] = time;
+                    ++time;
+                }
+            }
+            emitted[t] = true;
+        }
+        fanning = next_vertex(candidates, live, cache_time, time, cache_size, dead_ends, cursor);
+    }
+
+    // a trailing incomplete triangle is kept as is
+    output.insert(output.end(), indices.begin() + triangle_count * 3, indices.end());
+    indices = std::move(output);
+}
+
+auto detail::optimize_vertex_fetch(std::vector<std::byte>& vertices, std::size_t stride,
+                                   std::vector<unsigned>& indices) -> std::size_t {
+    const auto vertex_count = vertices.size() / stride;
+
+    std::vector<unsigned> remap(vertex_count, no_vertex);
+    std::vector<std::byte> reordered;
+    reordered.reserve(vertices.size());
+    unsigned next = 0;
+    for (auto& index : indices) {
+        if (remap[index] == no_vertex) {
+            remap[index] = next++;
+            const auto* src = vertices.data() + index * stride;
+            reordered.insert(reordered.end(), src, src + stride);
+        }
+        index = remap[index];
+    }
+    vertices = std::move(reordered);
+    return next;
+}
+
+auto detail::compute_acmr(const std::vector<unsigned>& indices, unsigned cache_size) -> float {
+    const auto triangle_count = indices.size() / 3;
+    if (triangle_count == 0)
+        return 0.f;
+
+    std::deque<unsigned> cache;
+    std::size_t misses = 0;
+    for (std::size_t i = 0; i < triangle_count * 3; ++i) {
+        if (std::find(cache.begin(), cache.end(), indices[i]) != cache.end())
+            continue;
+        ++misses;
+        cache.push_back(indices[i]);
+        if (cache.size() > cache_size)
+            cache.pop_front();
+    }
+    return static_cast<float>(misses) / static_cast<float>(triangle_count);
+}
+
+auto detail::optimize_mesh(std::vector<std::byte>& vertices, std::size_t stride, std::vector<unsigned>& indices,
+                           unsigned cache_size) -> MeshOptimizationReport {
+    MeshOptimizationReport report;
+    report.vertex_count_before = vertices.size() / stride;
+    report.acmr_before = compute_acmr(indices, cache_size);
+
+    auto vertex_count = deduplicate_vertices(vertices, stride, indices);
+    optimize_vertex_cache(indices, vertex_count, cache_size);
+    vertex_count = optimize_vertex_fetch(vertices, stride, indices);
+
+    report.vertex_count_after = vertex_count;
+    report.acmr_after = compute_acmr(indices, cache_size);
+    return report;
+}
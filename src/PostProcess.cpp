@@ -35,6 +35,18 @@ namespace {
             color = c;
         }
     );
+
+    auto get_vertex_stage() -> const ShaderStage& {
+        static auto loaded = false;
+        static ShaderStage vertex_stage;
+
+        if (!loaded) {
+            vertex_stage.load(Shader::Type::Vertex, {QUAD_VERT_SRC});
+            loaded = true;
+        }
+
+        return vertex_stage;
+    }
 }
 
 PostProcess::PostProcess(const std::string& post_process_shader_src) {
@@ -43,15 +55,8 @@ PostProcess::PostProcess(const std::string& post_process_shader_src) {
 }
 
 void PostProcess::set(const std::string& post_process_shader_src) {
-    auto vert_shader = Shader::compileVertex(QUAD_VERT_SRC);
-    auto frag_shader = Shader::compileFragment(QUAD_FRAG_SRC);
-    auto postprocess_shader = Shader::compileFragment(post_process_shader_src);
-
-    shader.load(vert_shader, frag_shader, postprocess_shader);
-
-    vert_shader.destroy();
-    frag_shader.destroy();
-    postprocess_shader.destroy();
+    fragment_stage->load(Shader::Type::Fragment, {QUAD_FRAG_SRC, post_process_shader_src});
+    pipeline.load(get_vertex_stage(), *fragment_stage);
 }
 
 auto PostProcess::getDefault() -> const PostProcess& {
@@ -0,0 +1,124 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#include <sogl/Quantization.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace sogl;
+
+namespace {
+    auto sign_not_zero(float v) -> float {
+        return v >= 0.f ? 1.f : -1.f;
+    }
+
+    auto oct_decode(float x, float y) -> glm::vec3 {
+        auto v = glm::vec3(x, y, 1.f - std::abs(x) - std::abs(y));
+        if (v.z < 0.f) {
+            const auto vx = v.x;
+            v.x = (1.f - std::abs(v.y)) * sign_not_zero(vx);
+            v.y = (1.f - std::abs(vx)) * sign_not_zero(v.y);
+        }
+        const auto length = std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+        return {v.x / length, v.y / length, v.z / length};
+    }
+}
+
+Quantizer::Quantizer(std::span<const glm::vec3> positions) :
+m_min(std::numeric_limits<float>::max()),
+m_extent(0.f) {
+    auto max = glm::vec3(std::numeric_limits<float>::lowest());
+    for (const auto& p : positions) {
+        for (int i = 0; i < 3; ++i) {
+            m_min[i] = std::min(m_min[i], p[i]);
+            max[i] = std::max(max[i], p[i]);
+        }
+    }
+    if (positions.empty()) {
+        m_min = glm::vec3(0.f);
+        max = glm::vec3(0.f);
+    }
+    for (int i = 0; i < 3; ++i) {
+        m_extent[i] = max[i] - m_min[i];
+    }
+}
+
+auto Quantizer::position(const glm::vec3& p) -> glm::u16vec4 {
+    constexpr auto max_value = 65535.f;
+
+    glm::u16vec4 q;
+    auto squared_error = 0.f;
+    for (int i = 0; i < 3; ++i) {
+        const auto t = m_extent[i] > 0.f ? std::clamp((p[i] - m_min[i]) / m_extent[i], 0.f, 1.f) : 0.f;
+        q[i] = static_cast<std::uint16_t>(std::lround(t * max_value));
+        const auto decoded = m_min[i] + static_cast<float>(q[i]) / max_value * m_extent[i];
+        squared_error += (decoded - p[i]) * (decoded - p[i]);
+    }
+    q.w = static_cast<std::uint16_t>(max_value);
+    m_position_error.add(std::sqrt(squared_error));
+    return q;
+}
+
+auto Quantizer::normal(const glm::vec3& n) -> glm::i16vec2 {
+    constexpr auto max_value = 32767.f;
+
+    const auto length = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+    const auto l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+    if (length == 0.f || l1 == 0.f)
+        return {};
+
+    // project on the octahedron, then fold the lower hemisphere over the upper one
+    auto x = n.x / l1;
+    auto y = n.y / l1;
+    if (n.z < 0.f) {
+        const auto folded_x = (1.f - std::abs(y)) * sign_not_zero(x);
+        y = (1.f - std::abs(x)) * sign_not_zero(y);
+        x = folded_x;
+    }
+
+    auto q = glm::i16vec2(static_cast<std::int16_t>(std::lround(std::clamp(x, -1.f, 1.f) * max_value)),
+                          static_cast<std::int16_t>(std::lround(std::clamp(y, -1.f, 1.f) * max_value)));
+
+    const auto decoded = oct_decode(static_cast<float>(q.x) / max_value, static_cast<float>(q.y) / max_value);
+    const auto cos_angle = (decoded.x * n.x + decoded.y * n.y + decoded.z * n.z) / length;
+    m_normal_error.add(std::acos(std::clamp(cos_angle, -1.f, 1.f)));
+    return q;
+}
+
+auto Quantizer::uv(const glm::vec2& t) -> glm::u8vec2 {
+    constexpr auto max_value = 255.f;
+
+    glm::u8vec2 q;
+    auto error = 0.f;
+    for (int i = 0; i < 2; ++i) {
+        q[i] = static_cast<std::uint8_t>(std::lround(std::clamp(t[i], 0.f, 1.f) * max_value));
+        error = std::max(error, std::abs(static_cast<float>(q[i]) / max_value - t[i]));
+    }
+    m_uv_error.add(error);
+    return q;
+}
+
+auto Quantizer::getDequantization() const -> glm::mat4 {
+    // scale by the extent then translate to the minimum corner of the bounding box
+    auto dequantization = glm::mat4(1.f);
+    for (int i = 0; i < 3; ++i) {
+        dequantization[i][i] = m_extent[i];
+        dequantization[3][i] = m_min[i];
+    }
+    return dequantization;
+}
+
+auto Quantizer::getReport() const -> QuantizationReport {
+    return {m_position_error.get(), m_normal_error.get(), m_uv_error.get()};
+}
+
+void Quantizer::ErrorAccumulator::add(float error) {
+    max = std::max(max, error);
+    sum += error;
+    ++count;
+}
+
+auto Quantizer::ErrorAccumulator::get() const -> QuantizationError {
+    return {max, count > 0 ? static_cast<float>(sum / static_cast<double>(count)) : 0.f, count};
+}
@@ -0,0 +1,121 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#include <sogl/RenderQueue.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+
+using namespace sogl;
+
+void detail::radix_sort(std::vector<std::pair<std::uint64_t, std::uint32_t>>& items,
+                        std::vector<std::pair<std::uint64_t, std::uint32_t>>& scratch) {
+    if (items.empty())
+        return;
+    scratch.resize(items.size());
+    for (unsigned shift = 0; shift < 64; shift += 8) {
+        std::array<std::size_t, 256> offsets = {};
+        for (const auto& item : items) {
+            ++offsets[(item.first >> shift) & 0xff];
+        }
+        // every key has the same digit, this pass would not move anything
+        if (offsets[(items.front().first >> shift) & 0xff] == items.size())
+            continue;
+
+        std::size_t sum = 0;
+        for (auto& offset : offsets) {
+            const auto count = offset;
+            offset = sum;
+            sum += count;
+        }
+        for (const auto& item : items) {
+            scratch[offsets[(item.first >> shift) & 0xff]++] = item;
+        }
+        items.swap(scratch);
+    }
+}
+
+void RenderQueue::clear() {
+    m_commands.clear();
+    m_keys.clear();
+    // ids are dense per execution, a destroyed object whose address is reused starts over
+    m_shader_ids.clear();
+    m_texture_ids.clear();
+    m_mesh_ids.clear();
+}
+
+void RenderQueue::execute() {
+    m_stats = {};
+    m_stats.draws = m_commands.size();
+    if (m_commands.empty())
+        return;
+
+    m_stats.state_changes_unsorted = countStateChanges(false);
+    detail::radix_sort(m_keys, m_scratch);
+    m_stats.state_changes = countStateChanges(true);
+
+    // the first draw binds everything, a null texture unbinds the one left from earlier rendering
+    const Command* previous = nullptr;
+    for (const auto& [key, index] : m_keys) {
+        const auto& command = m_commands[index];
+        const auto shader_changed = previous == nullptr || command.shader != previous->shader;
+        if (shader_changed) {
+            command.shader->bind();
+        }
+        if (previous == nullptr || command.texture != previous->texture) {
+            if (command.texture != nullptr)
+                command.texture->bind();
+            else
+                Texture::unbind();
+        }
+        // binding a mesh may set uniforms of the program in use, like the dequantization matrix
+        if (shader_changed || command.mesh != previous->mesh) {
+            command.bind_mesh(command.mesh);
+        }
+        if (command.uniforms != nullptr) {
+            command.uniforms(*command.shader, command.user_data);
+        }
+        command.render_mesh(command.mesh);
+        previous = &command;
+    }
+
+    clear();
+}
+
+auto RenderQueue::getStats() const -> const Stats& {
+    return m_stats;
+}
+
+void RenderQueue::push(const Command& command, std::uint8_t layer, float depth) {
+    const auto quantized_depth = static_cast<std::uint64_t>(std::lround(std::clamp(depth, 0.f, 1.f) * 65535.f));
+    const auto key = (static_cast<std::uint64_t>(layer) << 56)
+                   | (idOf(m_shader_ids, command.shader, 0xfff) << 44)
+                   | (idOf(m_texture_ids, command.texture, 0xfff) << 32)
+                   | (quantized_depth << 16)
+                   | idOf(m_mesh_ids, command.mesh, 0xffff);
+
+    m_keys.emplace_back(key, static_cast<std::uint32_t>(m_commands.size()));
+    m_commands.push_back(command);
+}
+
+auto RenderQueue::idOf(std::unordered_map<const void*, std::uint32_t>& ids, const void* object,
+                       std::uint32_t max_id) -> std::uint64_t {
+    const auto id = ids.try_emplace(object, static_cast<std::uint32_t>(ids.size())).first->second;
+    // a bigger id would alias another object in its key field
+    assert(id <= max_id);
+    return std::min(id, max_id);
+}
+
+auto RenderQueue::countStateChanges(bool sorted) const -> std::size_t {
+    std::size_t changes = 0;
+    const Command* previous = nullptr;
+    for (std::size_t i = 0; i < m_commands.size(); ++i) {
+        const auto& command = m_commands[sorted ? m_keys[i].second : i];
+        changes += previous == nullptr || command.shader != previous->shader;
+        changes += previous == nullptr || command.texture != previous->texture;
+        changes += previous == nullptr || command.shader != previous->shader || command.mesh != previous->mesh;
+        previous = &command;
+    }
+    return changes;
+}
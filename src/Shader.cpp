@@ -1,11 +1,20 @@
 // Created by Modar Nasser on 28/02/2022.
 
 #include <sogl/Shader.hpp>
+#include <sogl/GlState.hpp>
+#include <sogl/ShaderBatch.hpp>
+#include <sogl/StorageBuffer.hpp>
+#include <sogl/UniformBuffer.hpp>
 
 #include <GL/glew.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <string>
+#include <utility>
 
 using namespace sogl;
 
@@ -19,11 +28,13 @@ namespace {
         return message;
     }
 
-    auto compile(Shader::Type type, const std::string& src, const unsigned& handle) -> bool {
+    void submit_compile(const std::string& src, unsigned handle) {
         auto* src_c = src.c_str();
         glShaderSource(handle, 1, &src_c, nullptr);
         glCompileShader(handle);
+    }
 
+    auto check_compile(Shader::Type type, unsigned handle) -> bool {
         int status;
         glGetShaderiv(handle, GL_COMPILE_STATUS, &status);
 
@@ -32,6 +43,7 @@ namespace {
                 case Shader::Type::Vertex: return "Vertex";
                 case Shader::Type::Fragment: return "Fragment";
                 case Shader::Type::Geometry: return "Geometry";
+                case Shader::Type::Compute: return "Compute";
                 default: return "Unknown";
             }
         };
@@ -44,6 +56,121 @@ namespace {
 
         return true;
     }
+
+    auto compile(Shader::Type type, const std::string& src, const unsigned& handle) -> bool {
+        submit_compile(src, handle);
+        return check_compile(type, handle);
+    }
+
+    std::filesystem::path binary_cache_directory;
+
+    auto binary_cache_supported() -> bool {
+#if defined(EMSCRIPTEN)
+        return false;
+#else
+        // some drivers expose the extension without any binary format
+        static const auto supported = [] {
+            if (!GLEW_ARB_get_program_binary)
+                return false;
+            GLint formats = 0;
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+            return formats > 0;
+        }();
+        return supported;
+#endif
+    }
+
+    auto parallel_compile_supported() -> bool {
+#if defined(EMSCRIPTEN)
+        return false;
+#else
+        // lets the driver pick the number of compiler threads
+        static const auto supported = [] {
+            if (GLEW_KHR_parallel_shader_compile) {
+                glMaxShaderCompilerThreadsKHR(0xffffffff);
+                return true;
+            }
+            if (GLEW_ARB_parallel_shader_compile) {
+                glMaxShaderCompilerThreadsARB(0xffffffff);
+                return true;
+            }
+            return false;
+        }();
+        return supported;
+#endif
+    }
+
+    auto gl_shader_type(Shader::Type type) -> unsigned {
+        switch (type) {
+            case Shader::Type::Vertex: return GL_VERTEX_SHADER;
+            case Shader::Type::Geometry: return GL_GEOMETRY_SHADER;
+            case Shader::Type::Fragment: return GL_FRAGMENT_SHADER;
+#if !defined(EMSCRIPTEN)
+            case Shader::Type::Compute: return GL_COMPUTE_SHADER;
+#endif
+            default: break;
+        }
+        // no compute shaders in WebGL, creating the shader fails
+        return 0;
+    }
+
+    auto with_defines(std::string_view src, const std::vector<std::string>& defines) -> std::string {
+        if (defines.empty())
+            return std::string(src);
+
+        // #version must stay the first line
+        auto code = std::string();
+        if (src.starts_with("#version")) {
+            const auto eol = src.find('\n');
+            code = src.substr(0, eol);
+            code += '\n';
+            src = eol == std::string_view::npos ? std::string_view() : src.substr(eol + 1);
+        }
+        for (const auto& define : defines) {
+            code += "#define ";
+            code += define;
+            code += '\n';
+        }
+        code += src;
+        return code;
+    }
+
+    auto fnv1a(std::uint64_t hash, std::string_view data) -> std::uint64_t {
+        for (const auto c : data) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 0x100000001b3ull;
+        }
+        // separator, so that moving text from one string to the next changes the hash
+        hash ^= 0xff;
+        hash *= 0x100000001b3ull;
+        return hash;
+    }
+
+    auto gl_string(unsigned name) -> std::string_view {
+        const auto* str = reinterpret_cast<const char*>(glGetString(name));
+        return str != nullptr ? str : "";
+    }
+
+    auto binary_cache_file(const std::vector<Shader::Source>& sources, const std::vector<std::string>& codes,
+                           bool separable) -> std::filesystem::path {
+        // a driver update invalidates the binaries, the version is part of the key
+        auto hash = 0xcbf29ce484222325ull;
+        hash = fnv1a(hash, gl_string(GL_VENDOR));
+        hash = fnv1a(hash, gl_string(GL_RENDERER));
+        hash = fnv1a(hash, gl_string(GL_VERSION));
+        hash = fnv1a(hash, separable ? "separable" : "");
+        for (std::size_t i = 0; i < sources.size(); ++i) {
+            const auto type = static_cast<char>(sources[i].type);
+            hash = fnv1a(hash, std::string_view(&type, 1));
+            hash = fnv1a(hash, codes[i]);
+        }
+
+        auto name = std::string(16, '0');
+        for (std::size_t i = 0; i < name.size(); ++i) {
+            name[i] = "0123456789abcdef"[(hash >> (60 - 4 * i)) & 0xf];
+        }
+        return binary_cache_directory / (name + ".bin");
+    }
 }
 
 template <>
@@ -82,6 +209,18 @@ void Shader::CompiledShaderObject<Shader::Type::Fragment>::destroy() {
     if (handle) glDeleteShader(handle);
 }
 
+template <>
+Shader::CompiledShaderObject<Shader::Type::Compute>::CompiledShaderObject(const std::string& src) {
+    handle = glCreateShader(gl_shader_type(Shader::Type::Compute));
+    if (!compile(Shader::Type::Compute, src, handle)) {
+        destroy();
+    }
+}
+template <>
+void Shader::CompiledShaderObject<Shader::Type::Compute>::destroy() {
+    if (handle) glDeleteShader(handle);
+}
+
 void Shader::Program::create() {
     if (handle != 0) {
         destroy();
@@ -91,7 +230,9 @@ void Shader::Program::create() {
 
 void Shader::Program::destroy() {
     if (handle != 0) {
-        glDeleteProgram(handle);
+        detail::drop_reflection(handle);
+        GlState::current().deleteProgram(handle);
+        handle = 0;
     }
 }
 
@@ -103,6 +244,56 @@ void Shader::Program::detachShader(const ShaderObject& shader) {
     glDetachShader(handle, getHandle(shader));
 }
 
+void Shader::Program::attachShader(unsigned shader) {
+    glAttachShader(handle, shader);
+}
+
+void Shader::Program::detachShader(unsigned shader) {
+    glDetachShader(handle, shader);
+}
+
+void Shader::Program::setBinaryRetrievable() const {
+#if !defined(EMSCRIPTEN)
+    glProgramParameteri(handle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
+}
+
+void Shader::Program::setSeparable() const {
+#if !defined(EMSCRIPTEN)
+    glProgramParameteri(handle, GL_PROGRAM_SEPARABLE, GL_TRUE);
+#endif
+}
+
+void Shader::Program::useStages(unsigned pipeline, unsigned stages) const {
+#if !defined(EMSCRIPTEN)
+    glUseProgramStages(pipeline, stages, handle);
+#endif
+}
+
+auto Shader::Program::getBinary(unsigned& format) const -> std::vector<char> {
+    auto binary = std::vector<char>();
+#if !defined(EMSCRIPTEN)
+    GLint length = 0;
+    glGetProgramiv(handle, GL_PROGRAM_BINARY_LENGTH, &length);
+    binary.resize(length);
+    GLsizei written = 0;
+    GLenum binary_format = 0;
+    glGetProgramBinary(handle, length, &written, &binary_format, binary.data());
+    binary.resize(written);
+    format = binary_format;
+#endif
+    return binary;
+}
+
+auto Shader::Program::loadBinary(unsigned format, const std::vector<char>& binary) const -> bool {
+#if !defined(EMSCRIPTEN)
+    glProgramBinary(handle, format, binary.data(), static_cast<GLsizei>(binary.size()));
+    return getStatus(GL_LINK_STATUS) == GL_TRUE;
+#else
+    return false;
+#endif
+}
+
 void Shader::Program::link() const {
     glLinkProgram(handle);
 }
@@ -121,13 +312,107 @@ auto Shader::Program::getInfoLog() const -> std::string {
 }
 
 void Shader::Program::use() const {
-    glUseProgram(handle);
+    GlState::current().useProgram(handle);
+}
+
+auto Shader::Program::getId() const -> unsigned {
+    return handle;
 }
 
 auto Shader::Program::getUniformLocation(const std::string& uniform) const -> int {
     return glGetUniformLocation(handle, uniform.c_str());
 }
 
+void Shader::Program::bindUniformBlocks() const {
+    // blocks with the same name get the same binding point in every program
+    GLint count = 0;
+    GLint max_length = 0;
+    glGetProgramiv(handle, GL_ACTIVE_UNIFORM_BLOCKS, &count);
+    glGetProgramiv(handle, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &max_length);
+    std::string name;
+    for (GLint i = 0; i < count; ++i) {
+        GLsizei length = 0;
+        name.resize(max_length);
+        glGetActiveUniformBlockName(handle, i, max_length, &length, name.data());
+        name.resize(length);
+        glUniformBlockBinding(handle, i, detail::uniform_block_binding(name));
+    }
+}
+
+void Shader::Program::reflect() const {
+    auto reflection = ShaderReflection::reflect(handle);
+
+    auto& state = GlState::current();
+    const auto previous = state.getProgram();
+    state.useProgram(handle);
+
+    // a sampler starting on a non-zero unit has an explicit layout(binding = N), its units are kept
+    auto reserved = std::vector<bool>();
+    for (auto& uniform : reflection.uniforms) {
+        if (!ShaderReflection::isSampler(uniform.type))
+            continue;
+        GLint binding = 0;
+        glGetUniformiv(handle, uniform.location, &binding);
+        if (binding == 0)
+            continue;
+        uniform.unit = binding;
+        uniform.explicit_unit = true;
+        reserved.resize(std::max(reserved.size(), static_cast<std::size_t>(binding + uniform.size)));
+        std::fill_n(reserved.begin() + binding, uniform.size, true);
+    }
+
+    // the others get consecutive free units in the order of their names
+    auto unit = 0;
+    auto units = std::vector<GLint>();
+    for (auto& uniform : reflection.uniforms) {
+        if (!ShaderReflection::isSampler(uniform.type) || uniform.unit >= 0)
+            continue;
+        const auto is_free = [&] (int first) {
+            for (auto u = first; u < first + uniform.size; ++u) {
+                if (static_cast<std::size_t>(u) < reserved.size() && reserved[u])
+                    return false;
+            }
+            return true;
+        };
+        while (!is_free(unit)) {
+            ++unit;
+        }
+        uniform.unit = unit;
+        units.resize(uniform.size);
+        for (auto& u : units) {
+            u = unit++;
+        }
+        glUniform1iv(uniform.location, uniform.size, units.data());
+    }
+    state.useProgram(previous);
+
+    detail::set_reflection(handle, std::move(reflection));
+}
+
+auto Shader::Program::getReflection() const -> const ShaderReflection* {
+    return detail::find_reflection(handle);
+}
+
+void Shader::Program::bindStorageBlocks() const {
+#if !defined(EMSCRIPTEN)
+    if (!GLEW_ARB_shader_storage_buffer_object)
+        return;
+    // storage blocks with the same name get the same binding point in every program, as uniform blocks
+    GLint count = 0;
+    GLint max_length = 0;
+    glGetProgramInterfaceiv(handle, GL_SHADER_STORAGE_BLOCK, GL_ACTIVE_RESOURCES, &count);
+    glGetProgramInterfaceiv(handle, GL_SHADER_STORAGE_BLOCK, GL_MAX_NAME_LENGTH, &max_length);
+    std::string name;
+    for (GLint i = 0; i < count; ++i) {
+        GLsizei length = 0;
+        name.resize(max_length);
+        glGetProgramResourceName(handle, GL_SHADER_STORAGE_BLOCK, i, max_length, &length, name.data());
+        name.resize(length);
+        glShaderStorageBlockBinding(handle, i, detail::storage_block_binding(name));
+    }
+#endif
+}
+
 auto Shader::Program::getStatus(unsigned status_type) const -> int {
     int status = 0;
     glGetProgramiv(handle, status_type, &status);
@@ -139,6 +424,43 @@ Shader::Program::operator bool() {
 }
 
 Shader::~Shader() {
+    destroy();
+}
+
+Shader::Shader(Shader&& other) noexcept :
+m_program(std::move(other.m_program)),
+m_pending(std::exchange(other.m_pending, std::nullopt)),
+m_separable(other.m_separable),
+m_uniform_slots(std::move(other.m_uniform_slots)),
+m_uniforms(std::move(other.m_uniforms)),
+m_uniform_stats(other.m_uniform_stats),
+m_batch(std::exchange(other.m_batch, nullptr)) {
+    if (m_batch) m_batch->replace(other, *this);
+}
+
+auto Shader::operator=(Shader&& other) noexcept -> Shader& {
+    if (this != &other) {
+        destroy();
+        m_program = std::move(other.m_program);
+        m_pending = std::exchange(other.m_pending, std::nullopt);
+        m_separable = other.m_separable;
+        m_uniform_slots = std::move(other.m_uniform_slots);
+        m_uniforms = std::move(other.m_uniforms);
+        m_uniform_stats = other.m_uniform_stats;
+        m_batch = std::exchange(other.m_batch, nullptr);
+        if (m_batch) m_batch->replace(other, *this);
+    }
+    return *this;
+}
+
+void Shader::destroy() {
+    if (m_batch) m_batch->drop(*this);
+    if (m_pending) {
+        for (const auto& [type, object] : m_pending->objects) {
+            glDeleteShader(object);
+        }
+        m_pending.reset();
+    }
     if (m_program) m_program.destroy();
 }
 
@@ -146,10 +468,95 @@ void Shader::bind() const {
     m_program.use();
 }
 
-auto Shader::getUniformLocation(const std::string& uniform) const -> int {
-    if (m_uniforms_location.count(uniform) == 0)
-        m_uniforms_location[uniform] = m_program.getUniformLocation(uniform);
-    return m_uniforms_location.at(uniform);
+#if !defined(EMSCRIPTEN)
+void Shader::dispatch(unsigned groups_x, unsigned groups_y, unsigned groups_z) const {
+    m_program.use();
+    glDispatchCompute(groups_x, groups_y, groups_z);
+}
+
+void Shader::memoryBarrier(Barrier barriers) {
+    glMemoryBarrier(static_cast<GLbitfield>(barriers));
+}
+
+auto sogl::operator|(const Barrier& left, const Barrier& right) -> Barrier {
+    return Barrier(static_cast<std::underlying_type_t<Barrier>>(left) |
+                   static_cast<std::underlying_type_t<Barrier>>(right));
+}
+#endif
+
+auto Shader::getUniformLocation(std::string_view uniform) const -> int {
+    return m_uniforms[getUniformSlot(uniform)].location;
+}
+
+auto Shader::getReflection() const -> const ShaderReflection& {
+    static const ShaderReflection empty;
+    const auto* reflection = m_program.getReflection();
+    return reflection != nullptr ? *reflection : empty;
+}
+
+auto Shader::getSamplerUnit(std::string_view sampler) const -> int {
+    const auto* uniform = getReflection().findUniform(sampler);
+    return uniform != nullptr ? uniform->unit : -1;
+}
+
+auto Shader::beginUpload() const -> unsigned {
+    auto& state = GlState::current();
+    const auto previous = state.getProgram();
+    // a program in use also takes priority over the active program of a bound pipeline
+    state.useProgram(m_program.getId());
+    return previous;
+}
+
+void Shader::endUpload(unsigned previous) const {
+    GlState::current().useProgram(previous);
+}
+
+auto Shader::getUniformStats() const -> const UniformStats& {
+    return m_uniform_stats;
+}
+
+void Shader::resetUniformStats() {
+    m_uniform_stats = {};
+}
+
+auto Shader::getUniformSlot(std::string_view uniform) const -> unsigned {
+    if (const auto it = m_uniform_slots.find(uniform); it != m_uniform_slots.end())
+        return it->second;
+
+    const auto slot = static_cast<unsigned>(m_uniforms.size());
+    m_uniforms.push_back({findUniformLocation(uniform)});
+    m_uniform_slots.emplace(uniform, slot);
+    return slot;
+}
+
+auto Shader::findUniformLocation(std::string_view uniform) const -> int {
+    if (const auto* entry = getReflection().findUniform(uniform))
+        return entry->location;
+    // elements of arrays and members of arrays of structs are listed under the first element only
+    if (uniform.find('[') != std::string_view::npos)
+        return m_program.getUniformLocation(std::string(uniform));
+    return -1;
+}
+
+auto Shader::loadSources(const std::vector<Source>& sources, const std::vector<std::string>& defines) -> bool {
+    submitSources(sources, defines);
+    return finishSources();
+}
+
+void Shader::setBinaryCacheDirectory(const std::filesystem::path& directory) {
+    binary_cache_directory = directory;
+    if (!directory.empty()) {
+        auto error = std::error_code();
+        std::filesystem::create_directories(directory, error);
+        if (error) {
+            std::cerr << "Failed to create shader cache directory " << directory << " : " << error.message() << std::endl;
+            binary_cache_directory.clear();
+        }
+    }
+}
+
+auto Shader::isReady() const -> bool {
+    return !m_pending.has_value();
 }
 
 auto Shader::compileVertex(const std::string& src) -> CompiledShaderObject<Type::Vertex> {
@@ -164,6 +571,10 @@ auto Shader::compileFragment(const std::string& src) -> CompiledShaderObject<Typ
     return CompiledShaderObject<Type::Fragment>(src);
 }
 
+auto Shader::compileCompute(const std::string& src) -> CompiledShaderObject<Type::Compute> {
+    return CompiledShaderObject<Type::Compute>(src);
+}
+
 void Shader::attach(const ShaderObject& handle) {
     m_program.attachShader(handle);
 }
@@ -174,6 +585,10 @@ void Shader::detach(const ShaderObject& handle) {
 
 auto Shader::linkAndValidate() -> bool {
     m_program.link();
+    return checkLink();
+}
+
+auto Shader::checkLink() -> bool {
     m_program.validate();
 
     if (m_program.getStatus(GL_LINK_STATUS) == GL_FALSE) {
@@ -182,6 +597,8 @@ auto Shader::linkAndValidate() -> bool {
         return false;
     }
 
+    onLinked();
+
     if (m_program.getStatus(GL_VALIDATE_STATUS) == GL_FALSE) {
         std::cerr << "Failed to validate shader program :\n"
                   << m_program.getInfoLog() << std::endl;
@@ -190,3 +607,130 @@ auto Shader::linkAndValidate() -> bool {
 
     return true;
 }
+
+void Shader::onLinked() {
+    m_program.bindUniformBlocks();
+    m_program.bindStorageBlocks();
+    m_program.reflect();
+
+    // uniforms resolved before a reload keep their slot, handles stay valid.
+    // linking resets the values of the program
+    for (const auto& [name, slot] : m_uniform_slots) {
+        m_uniforms[slot].location = findUniformLocation(name);
+        m_uniforms[slot].size = 0;
+    }
+}
+
+void Shader::submitSources(const std::vector<Source>& sources, const std::vector<std::string>& defines) {
+    // the previous sources are replaced
+    destroy();
+
+    auto codes = std::vector<std::string>();
+    codes.reserve(sources.size());
+    for (const auto& source : sources) {
+        codes.push_back(with_defines(source.code, defines));
+    }
+
+    auto pending = PendingLink();
+    if (!binary_cache_directory.empty() && binary_cache_supported()) {
+        pending.cache_file = binary_cache_file(sources, codes, m_separable);
+        if (loadBinary(pending.cache_file)) {
+            m_pending.reset();
+            return;
+        }
+    }
+
+    // no status query until finishSources, the driver is free to compile in the background
+    m_program.create();
+    if (m_separable) {
+        m_program.setSeparable();
+    }
+    for (std::size_t i = 0; i < sources.size(); ++i) {
+        const auto object = glCreateShader(gl_shader_type(sources[i].type));
+        submit_compile(codes[i], object);
+        m_program.attachShader(object);
+        pending.objects.emplace_back(sources[i].type, object);
+    }
+
+    if (!pending.cache_file.empty()) {
+        m_program.setBinaryRetrievable();
+    }
+    m_program.link();
+    m_pending = std::move(pending);
+}
+
+auto Shader::hasParallelCompile() -> bool {
+    return parallel_compile_supported();
+}
+
+auto Shader::isLinkDone() const -> bool {
+    if (!m_pending)
+        return true;
+    // without the extension there is no way to know, checking the status waits for the driver
+    if (!parallel_compile_supported())
+        return true;
+#if !defined(EMSCRIPTEN)
+    return m_program.getStatus(GL_COMPLETION_STATUS_KHR) == GL_TRUE;
+#else
+    return true;
+#endif
+}
+
+auto Shader::finishSources() -> bool {
+    if (!m_pending)
+        return true;
+
+    auto pending = std::move(*m_pending);
+    m_pending.reset();
+
+    auto compiled = true;
+    for (const auto& [type, object] : pending.objects) {
+        compiled = check_compile(type, object) && compiled;
+    }
+    const auto linked = compiled && checkLink();
+
+    for (const auto& [type, object] : pending.objects) {
+        m_program.detachShader(object);
+        glDeleteShader(object);
+    }
+
+    if (linked && !pending.cache_file.empty()) {
+        saveBinary(pending.cache_file);
+    }
+    return linked;
+}
+
+auto Shader::loadBinary(const std::filesystem::path& file) -> bool {
+    auto stream = std::ifstream(file, std::ios::binary);
+    if (!stream)
+        return false;
+
+    std::uint32_t format = 0;
+    stream.read(reinterpret_cast<char*>(&format), sizeof(format));
+    const auto binary = std::vector<char>(std::istreambuf_iterator<char>(stream), {});
+    if (binary.empty())
+        return false;
+
+    // a rejected binary is overwritten once the sources are compiled again
+    m_program.create();
+    if (!m_program.loadBinary(format, binary))
+        return false;
+
+    onLinked();
+    return true;
+}
+
+void Shader::saveBinary(const std::filesystem::path& file) const {
+    auto format = 0u;
+    const auto binary = m_program.getBinary(format);
+    if (binary.empty())
+        return;
+
+    auto stream = std::ofstream(file, std::ios::binary | std::ios::trunc);
+    const auto stored_format = static_cast<std::uint32_t>(format);
+    stream.write(reinterpret_cast<const char*>(&stored_format), sizeof(stored_format));
+    stream.write(binary.data(), static_cast<std::streamsize>(binary.size()));
+    if (!stream) {
+        std::cerr << "Failed to write shader cache file " << file << std::endl;
+    }
+}
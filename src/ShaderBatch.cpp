@@ -0,0 +1,87 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#include <sogl/ShaderBatch.hpp>
+
+#include <algorithm>
+
+using namespace sogl;
+
+ShaderBatch::~ShaderBatch() {
+    for (auto* shader : m_pending) {
+        shader->m_batch = nullptr;
+    }
+}
+
+void ShaderBatch::add(Shader& shader, const std::vector<Shader::Source>& sources, const std::vector<std::string>& defines) {
+    ++m_stats.total;
+    shader.submitSources(sources, defines);
+    // restored from the binary cache
+    if (shader.isReady()) {
+        ++m_stats.done;
+        return;
+    }
+    m_pending.push_back(&shader);
+    shader.m_batch = this;
+}
+
+auto ShaderBatch::poll() -> bool {
+    if (!Shader::hasParallelCompile()) {
+        // every status query waits for the driver
+        if (!m_pending.empty()) {
+            finish(*m_pending.front());
+            m_pending.erase(m_pending.begin());
+        }
+        return isDone();
+    }
+
+    std::erase_if(m_pending, [this] (Shader* shader) {
+        if (!shader->isLinkDone())
+            return false;
+        finish(*shader);
+        return true;
+    });
+    return isDone();
+}
+
+void ShaderBatch::wait() {
+    for (auto* shader : m_pending) {
+        finish(*shader);
+    }
+    m_pending.clear();
+}
+
+auto ShaderBatch::isDone() const -> bool {
+    return m_pending.empty();
+}
+
+auto ShaderBatch::getStats() const -> const Stats& {
+    return m_stats;
+}
+
+void ShaderBatch::finish(Shader& shader) {
+    shader.m_batch = nullptr;
+    // already finished and counted, like a shader that get() needed before the batch reached it
+    if (shader.isReady())
+        return;
+    if (!shader.finishSources()) {
+        ++m_stats.failed;
+    }
+    ++m_stats.done;
+}
+
+void ShaderBatch::finishNow(Shader& shader) {
+    std::erase(m_pending, &shader);
+    finish(shader);
+}
+
+void ShaderBatch::drop(Shader& shader) {
+    std::erase(m_pending, &shader);
+    shader.m_batch = nullptr;
+    if (!shader.isReady()) {
+        --m_stats.total;
+    }
+}
+
+void ShaderBatch::replace(const Shader& from, Shader& to) {
+    std::replace(m_pending.begin(), m_pending.end(), const_cast<Shader*>(&from), &to);
+}
@@ -0,0 +1,162 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#include <sogl/ShaderLibrary.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+using namespace sogl;
+
+namespace {
+    // name of a #include "name" or #include <name> line, empty for any other line
+    auto include_name(std::string_view line) -> std::string_view {
+        const auto first = line.find_first_not_of(" \t");
+        if (first == std::string_view::npos || !line.substr(first).starts_with("#include"))
+            return {};
+        line = line.substr(first + 8);
+        const auto open = line.find_first_of("\"<");
+        if (open == std::string_view::npos)
+            return {};
+        const auto close = line.find_first_of("\">", open + 1);
+        if (close == std::string_view::npos)
+            return {};
+        return line.substr(open + 1, close - open - 1);
+    }
+}
+
+void ShaderLibrary::addSource(std::string name, std::string code) {
+    m_sources.insert_or_assign(std::move(name), std::move(code));
+}
+
+auto ShaderLibrary::loadSource(std::string name, const std::filesystem::path& file) -> bool {
+    auto stream = std::ifstream(file, std::ios::binary);
+    if (!stream) {
+        std::cerr << "Failed to open shader source " << file << std::endl;
+        return false;
+    }
+    addSource(std::move(name), std::string(std::istreambuf_iterator<char>(stream), {}));
+    return true;
+}
+
+auto ShaderLibrary::addDefine(std::string define) -> Variant {
+    assert(m_defines.size() < 64);
+    m_defines.push_back(std::move(define));
+    return Variant(1) << (m_defines.size() - 1);
+}
+
+auto ShaderLibrary::addProgram(std::vector<std::pair<Shader::Type, std::string>> stages) -> ProgramId {
+    m_programs.push_back({std::move(stages), {}});
+    return static_cast<ProgramId>(m_programs.size() - 1);
+}
+
+auto ShaderLibrary::get(ProgramId program, Variant variant) -> Shader& {
+    auto& entry = m_programs[program];
+    auto [it, inserted] = entry.variants.try_emplace(variant);
+    if (inserted) {
+        submit(entry, variant, it->second, nullptr);
+    } else if (!it->second.isReady()) {
+        // prewarmed in a batch that was not polled to the end, the batch counts it and moves on
+        if (it->second.m_batch != nullptr) {
+            it->second.m_batch->finishNow(it->second);
+        } else {
+            it->second.finishSources();
+        }
+    }
+    return it->second;
+}
+
+void ShaderLibrary::prewarm(ProgramId program, std::span<const Variant> variants) {
+    auto batch = ShaderBatch();
+    prewarm(program, variants, batch);
+    batch.wait();
+}
+
+void ShaderLibrary::prewarm(ProgramId program, std::span<const Variant> variants, ShaderBatch& batch) {
+    auto& entry = m_programs[program];
+    for (const auto variant : variants) {
+        auto [it, inserted] = entry.variants.try_emplace(variant);
+        if (inserted) {
+            submit(entry, variant, it->second, &batch);
+        }
+    }
+}
+
+void ShaderLibrary::release(ProgramId program, Variant variant) {
+    // a variant still pending in a batch is dropped from it when destroyed
+    m_programs[program].variants.erase(variant);
+}
+
+auto ShaderLibrary::getVariantCount() const -> std::size_t {
+    auto count = std::size_t(0);
+    for (const auto& program : m_programs) {
+        count += program.variants.size();
+    }
+    return count;
+}
+
+auto ShaderLibrary::preprocess(std::string_view code) const -> std::string {
+    auto result = std::string();
+    auto included = std::vector<std::string_view>();
+    expand(code, result, included);
+    return result;
+}
+
+void ShaderLibrary::expand(std::string_view code, std::string& result, std::vector<std::string_view>& included) const {
+    while (!code.empty()) {
+        const auto eol = code.find('\n');
+        const auto line = code.substr(0, eol);
+        code = eol == std::string_view::npos ? std::string_view() : code.substr(eol + 1);
+
+        const auto name = include_name(line);
+        if (name.empty()) {
+            result += line;
+            result += '\n';
+            continue;
+        }
+
+        // also stops include cycles
+        if (std::find(included.begin(), included.end(), name) != included.end())
+            continue;
+
+        const auto it = m_sources.find(std::string(name));
+        if (it == m_sources.end()) {
+            std::cerr << "Shader include \"" << name << "\" not found" << std::endl;
+            continue;
+        }
+        included.push_back(it->first);
+        expand(it->second, result, included);
+    }
+}
+
+void ShaderLibrary::submit(const Program& program, Variant variant, Shader& shader, ShaderBatch* batch) const {
+    auto codes = std::vector<std::string>();
+    codes.reserve(program.stages.size());
+    for (const auto& [type, name] : program.stages) {
+        const auto it = m_sources.find(name);
+        if (it == m_sources.end()) {
+            std::cerr << "Shader source \"" << name << "\" not found" << std::endl;
+        }
+        codes.push_back(preprocess(it != m_sources.end() ? it->second : std::string()));
+    }
+
+    auto sources = std::vector<Shader::Source>();
+    for (std::size_t i = 0; i < codes.size(); ++i) {
+        sources.push_back({program.stages[i].first, codes[i]});
+    }
+
+    auto defines = std::vector<std::string>();
+    for (std::size_t i = 0; i < m_defines.size(); ++i) {
+        if (variant & (Variant(1) << i)) {
+            defines.push_back(m_defines[i]);
+        }
+    }
+
+    if (batch != nullptr) {
+        batch->add(shader, sources, defines);
+    } else {
+        shader.loadSources(sources, defines);
+    }
+}
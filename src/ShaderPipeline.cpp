@@ -0,0 +1,218 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#include <sogl/ShaderPipeline.hpp>
+#include <sogl/GlState.hpp>
+
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <utility>
+
+using namespace sogl;
+
+namespace {
+    auto stage_bit(Shader::Type type) -> unsigned {
+        switch (type) {
+            case Shader::Type::Vertex: return GL_VERTEX_SHADER_BIT;
+            case Shader::Type::Geometry: return GL_GEOMETRY_SHADER_BIT;
+            case Shader::Type::Fragment: return GL_FRAGMENT_SHADER_BIT;
+#if !defined(EMSCRIPTEN)
+            case Shader::Type::Compute: return GL_COMPUTE_SHADER_BIT;
+#endif
+            default: break;
+        }
+        return 0;
+    }
+
+    // every load of a pipeline gets its own id, stages remember the one whose sampler units they hold
+    std::uint64_t last_load_id = 0;
+}
+
+auto ShaderStage::load(Shader::Type type, std::vector<std::string> sources) -> bool {
+    m_type = type;
+    m_sources = std::move(sources);
+    if (!ShaderPipeline::isSupported())
+        return true;
+
+    auto stage_sources = std::vector<Shader::Source>();
+    for (const auto& source : m_sources) {
+        stage_sources.push_back({type, source});
+    }
+    m_shader.m_separable = true;
+    m_sampler_units_of = 0;
+    return m_shader.loadSources(stage_sources);
+}
+
+auto ShaderStage::getType() const -> Shader::Type {
+    return m_type;
+}
+
+ShaderPipeline::~ShaderPipeline() {
+    if (m_pipeline != 0) {
+        GlState::current().deleteProgramPipeline(m_pipeline);
+    }
+}
+
+ShaderPipeline::ShaderPipeline(ShaderPipeline&& other) noexcept :
+m_pipeline(std::exchange(other.m_pipeline, 0)),
+m_load_id(std::exchange(other.m_load_id, 0)),
+m_stages(std::move(other.m_stages)),
+m_samplers(std::move(other.m_samplers)),
+m_monolithic(std::move(other.m_monolithic)) {}
+
+ShaderPipeline& ShaderPipeline::operator=(ShaderPipeline&& other) noexcept {
+    if (this != &other) {
+        if (m_pipeline != 0) {
+            GlState::current().deleteProgramPipeline(m_pipeline);
+        }
+        m_pipeline = std::exchange(other.m_pipeline, 0);
+        m_load_id = std::exchange(other.m_load_id, 0);
+        m_stages = std::move(other.m_stages);
+        m_samplers = std::move(other.m_samplers);
+        m_monolithic = std::move(other.m_monolithic);
+    }
+    return *this;
+}
+
+auto ShaderPipeline::isSupported() -> bool {
+#if defined(EMSCRIPTEN)
+    return false;
+#else
+    return GLEW_ARB_separate_shader_objects;
+#endif
+}
+
+void ShaderPipeline::bind() const {
+    auto& state = GlState::current();
+    if (m_pipeline == 0) {
+        m_monolithic.bind();
+        return;
+    }
+    // a program in use has priority over the bound pipeline
+    state.useProgram(0);
+    state.bindProgramPipeline(m_pipeline);
+    uploadSamplerUnits();
+}
+
+auto ShaderPipeline::getSamplerUnit(std::string_view sampler) const -> int {
+    if (m_pipeline == 0)
+        return m_monolithic.getSamplerUnit(sampler);
+    const auto it = std::find_if(m_samplers.begin(), m_samplers.end(), [&] (const Sampler& s) {
+        return s.name == sampler;
+    });
+    return it != m_samplers.end() ? it->unit : -1;
+}
+
+auto ShaderPipeline::loadStages(std::vector<const ShaderStage*> stages) -> bool {
+    m_stages = std::move(stages);
+    m_samplers.clear();
+
+    if (!isSupported()) {
+        auto sources = std::vector<Shader::Source>();
+        for (const auto* stage : m_stages) {
+            for (const auto& source : stage->m_sources) {
+                sources.push_back({stage->m_type, source});
+            }
+        }
+        return m_monolithic.loadSources(sources);
+    }
+
+#if !defined(EMSCRIPTEN)
+    for (const auto* stage : m_stages) {
+        const auto& program = stage->m_shader.m_program;
+        if (program.getId() == 0 || program.getStatus(GL_LINK_STATUS) == GL_FALSE) {
+            std::cerr << "Failed to load shader pipeline : a stage did not link" << std::endl;
+            return false;
+        }
+    }
+
+    if (m_pipeline == 0) {
+        glGenProgramPipelines(1, &m_pipeline);
+    }
+    auto used_stages = 0u;
+    for (const auto* stage : m_stages) {
+        stage->m_shader.m_program.useStages(m_pipeline, stage_bit(stage->m_type));
+        used_stages |= stage_bit(stage->m_type);
+    }
+    // stages of a previous load that are not replaced
+    const auto unused_stages = (GL_VERTEX_SHADER_BIT | GL_GEOMETRY_SHADER_BIT | GL_FRAGMENT_SHADER_BIT) & ~used_stages;
+    if (unused_stages != 0) {
+        glUseProgramStages(m_pipeline, unused_stages, 0);
+    }
+
+    // validation depends on the state at draw time, debug draws check it
+    m_load_id = ++last_load_id;
+    assignSamplerUnits();
+#endif
+    return true;
+}
+
+void ShaderPipeline::assignSamplerUnits() {
+    // units of explicit layout(binding = N) are kept
+    auto reserved = std::vector<bool>();
+    for (const auto* stage : m_stages) {
+        const auto* reflection = stage->m_shader.m_program.getReflection();
+        if (reflection == nullptr)
+            continue;
+        for (const auto& uniform : reflection->uniforms) {
+            if (!ShaderReflection::isSampler(uniform.type) || !uniform.explicit_unit)
+                continue;
+            m_samplers.push_back({uniform.name, stage, uniform.location, uniform.size, uniform.unit});
+            reserved.resize(std::max(reserved.size(), static_cast<std::size_t>(uniform.unit + uniform.size)));
+            std::fill_n(reserved.begin() + uniform.unit, uniform.size, true);
+        }
+    }
+
+    // the others get consecutive free units, stage after stage
+    auto unit = 0;
+    for (const auto* stage : m_stages) {
+        const auto* reflection = stage->m_shader.m_program.getReflection();
+        if (reflection == nullptr)
+            continue;
+        for (const auto& uniform : reflection->uniforms) {
+            if (!ShaderReflection::isSampler(uniform.type) || uniform.explicit_unit)
+                continue;
+            const auto shared = std::find_if(m_samplers.begin(), m_samplers.end(), [&] (const Sampler& s) {
+                return s.name == uniform.name && s.size == uniform.size;
+            });
+            if (shared != m_samplers.end()) {
+                m_samplers.push_back({uniform.name, stage, uniform.location, uniform.size, shared->unit});
+                continue;
+            }
+            const auto is_free = [&] (int first) {
+                for (auto u = first; u < first + uniform.size; ++u) {
+                    if (static_cast<std::size_t>(u) < reserved.size() && reserved[u])
+                        return false;
+                }
+                return true;
+            };
+            while (!is_free(unit)) {
+                ++unit;
+            }
+            m_samplers.push_back({uniform.name, stage, uniform.location, uniform.size, unit});
+            unit += uniform.size;
+        }
+    }
+}
+
+void ShaderPipeline::uploadSamplerUnits() const {
+#if !defined(EMSCRIPTEN)
+    auto units = std::vector<GLint>();
+    for (const auto* stage : m_stages) {
+        if (stage->m_sampler_units_of == m_load_id)
+            continue;
+        const auto program = stage->m_shader.m_program.getId();
+        for (const auto& sampler : m_samplers) {
+            if (sampler.stage != stage)
+                continue;
+            units.resize(sampler.size);
+            std::iota(units.begin(), units.end(), sampler.unit);
+            glProgramUniform1iv(program, sampler.location, sampler.size, units.data());
+        }
+        stage->m_sampler_units_of = m_load_id;
+    }
+#endif
+}
@@ -0,0 +1,224 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#include <sogl/ShaderReflection.hpp>
+
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <iostream>
+#include <set>
+#include <unordered_map>
+#include <utility>
+
+using namespace sogl;
+
+namespace {
+    std::unordered_map<unsigned, ShaderReflection> reflections;
+    std::set<std::pair<unsigned, const void*>> checked_layouts;
+    std::set<unsigned> reported_pipelines;
+
+    template <typename T>
+    auto find_by_name(const std::vector<T>& table, std::string_view name) -> const T* {
+        const auto it = std::lower_bound(table.begin(), table.end(), name, [] (const T& entry, std::string_view n) {
+            return entry.name < n;
+        });
+        return it != table.end() && it->name == name ? &*it : nullptr;
+    }
+
+    template <typename T>
+    void sort_by_name(std::vector<T>& table) {
+        std::sort(table.begin(), table.end(), [] (const T& a, const T& b) { return a.name < b.name; });
+    }
+
+    void strip_array_suffix(std::string& name) {
+        if (name.ends_with("[0]")) {
+            name.resize(name.size() - 3);
+        }
+    }
+
+    auto input_locations(unsigned type) -> int {
+        switch (type) {
+            case GL_FLOAT_MAT2: case GL_FLOAT_MAT2x3: case GL_FLOAT_MAT2x4: return 2;
+            case GL_FLOAT_MAT3: case GL_FLOAT_MAT3x2: case GL_FLOAT_MAT3x4: return 3;
+            case GL_FLOAT_MAT4: case GL_FLOAT_MAT4x2: case GL_FLOAT_MAT4x3: return 4;
+            default: return 1;
+        }
+    }
+
+    auto is_integer_input(unsigned type) -> bool {
+        switch (type) {
+            case GL_INT: case GL_INT_VEC2: case GL_INT_VEC3: case GL_INT_VEC4:
+            case GL_UNSIGNED_INT: case GL_UNSIGNED_INT_VEC2: case GL_UNSIGNED_INT_VEC3: case GL_UNSIGNED_INT_VEC4:
+                return true;
+            default:
+                return false;
+        }
+    }
+}
+
+auto ShaderReflection::findUniform(std::string_view name) const -> const Uniform* {
+    return find_by_name(uniforms, name);
+}
+
+auto ShaderReflection::findBlock(std::string_view name) const -> const Block* {
+    return find_by_name(blocks, name);
+}
+
+auto ShaderReflection::findInput(std::string_view name) const -> const Input* {
+    return find_by_name(inputs, name);
+}
+
+auto ShaderReflection::reflect(unsigned program) -> ShaderReflection {
+    auto reflection = ShaderReflection();
+    auto name = std::string();
+    GLint count = 0;
+    GLint max_length = 0;
+
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_length);
+    for (GLint i = 0; i < count; ++i) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        name.resize(max_length);
+        glGetActiveUniform(program, i, max_length, &length, &size, &type, name.data());
+        name.resize(length);
+
+        // members of uniform blocks have no location, they are set through UniformBuffer
+        const auto index = static_cast<GLuint>(i);
+        GLint block = -1;
+        glGetActiveUniformsiv(program, 1, &index, GL_UNIFORM_BLOCK_INDEX, &block);
+        if (block >= 0)
+            continue;
+
+        strip_array_suffix(name);
+        reflection.uniforms.push_back({name, type, size, glGetUniformLocation(program, name.c_str())});
+    }
+
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &count);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &max_length);
+    for (GLint i = 0; i < count; ++i) {
+        GLsizei length = 0;
+        GLint binding = 0;
+        name.resize(max_length);
+        glGetActiveUniformBlockName(program, i, max_length, &length, name.data());
+        name.resize(length);
+        glGetActiveUniformBlockiv(program, i, GL_UNIFORM_BLOCK_BINDING, &binding);
+        reflection.blocks.push_back({name, static_cast<unsigned>(binding)});
+    }
+
+    glGetProgramiv(program, GL_ACTIVE_ATTRIBUTES, &count);
+    glGetProgramiv(program, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &max_length);
+    for (GLint i = 0; i < count; ++i) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        name.resize(max_length);
+        glGetActiveAttrib(program, i, max_length, &length, &size, &type, name.data());
+        name.resize(length);
+
+        // built-in inputs such as gl_VertexID are not fed by vertex arrays
+        if (name.starts_with("gl_"))
+            continue;
+
+        strip_array_suffix(name);
+        reflection.inputs.push_back({name, type, size, glGetAttribLocation(program, name.c_str())});
+    }
+
+    sort_by_name(reflection.uniforms);
+    sort_by_name(reflection.blocks);
+    sort_by_name(reflection.inputs);
+    return reflection;
+}
+
+auto ShaderReflection::isSampler(unsigned type) -> bool {
+    switch (type) {
+        case GL_SAMPLER_2D: case GL_SAMPLER_3D: case GL_SAMPLER_CUBE:
+        case GL_SAMPLER_2D_SHADOW: case GL_SAMPLER_2D_ARRAY: case GL_SAMPLER_2D_ARRAY_SHADOW: case GL_SAMPLER_CUBE_SHADOW:
+        case GL_INT_SAMPLER_2D: case GL_INT_SAMPLER_3D: case GL_INT_SAMPLER_CUBE: case GL_INT_SAMPLER_2D_ARRAY:
+        case GL_UNSIGNED_INT_SAMPLER_2D: case GL_UNSIGNED_INT_SAMPLER_3D: case GL_UNSIGNED_INT_SAMPLER_CUBE:
+        case GL_UNSIGNED_INT_SAMPLER_2D_ARRAY:
+#if !defined(EMSCRIPTEN)
+        case GL_SAMPLER_1D: case GL_SAMPLER_1D_SHADOW: case GL_SAMPLER_1D_ARRAY: case GL_SAMPLER_1D_ARRAY_SHADOW:
+        case GL_SAMPLER_2D_RECT: case GL_SAMPLER_2D_RECT_SHADOW: case GL_SAMPLER_BUFFER:
+        case GL_SAMPLER_2D_MULTISAMPLE: case GL_SAMPLER_2D_MULTISAMPLE_ARRAY:
+        case GL_INT_SAMPLER_BUFFER: case GL_UNSIGNED_INT_SAMPLER_BUFFER:
+#endif
+            return true;
+        default:
+            return false;
+    }
+}
+
+auto detail::find_reflection(unsigned program) -> const ShaderReflection* {
+    const auto it = reflections.find(program);
+    return it != reflections.end() ? &it->second : nullptr;
+}
+
+void detail::set_reflection(unsigned program, ShaderReflection reflection) {
+    drop_reflection(program);
+    reflections.emplace(program, std::move(reflection));
+}
+
+void detail::drop_reflection(unsigned program) {
+    // the name may be reused by the driver for a program with other inputs
+    reflections.erase(program);
+    std::erase_if(checked_layouts, [&] (const auto& checked) { return checked.first == program; });
+}
+
+auto detail::uniform_location(unsigned program, std::string_view uniform) -> int {
+    const auto* reflection = find_reflection(program);
+    if (reflection == nullptr)
+        return -1;
+    const auto* entry = reflection->findUniform(uniform);
+    return entry != nullptr ? entry->location : -1;
+}
+
+void detail::check_vertex_inputs(unsigned program, std::span<const VertexInputDesc> attribs) {
+    if (program == 0 || !checked_layouts.emplace(program, attribs.data()).second)
+        return;
+
+    const auto* reflection = find_reflection(program);
+    if (reflection == nullptr)
+        return;
+
+    for (const auto& input : reflection->inputs) {
+        if (input.location < 0)
+            continue;
+        const auto locations = input_locations(input.type) * input.size;
+        for (int i = 0; i < locations; ++i) {
+            const auto location = static_cast<unsigned>(input.location + i);
+            const auto it = std::find_if(attribs.begin(), attribs.end(), [&] (const VertexInputDesc& attrib) {
+                return attrib.location == location;
+            });
+            if (it == attribs.end()) {
+                std::cerr << "Vertex input " << input.name << " at location " << location
+                          << " is not provided by the vertex array" << std::endl;
+            } else if (it->integer != is_integer_input(input.type)) {
+                std::cerr << "Vertex input " << input.name << " at location " << location << " reads "
+                          << (is_integer_input(input.type) ? "integers" : "floats") << " but the vertex array provides "
+                          << (it->integer ? "integers" : "floats") << std::endl;
+            }
+        }
+    }
+}
+
+void detail::check_program_pipeline(unsigned pipeline) {
+#if !defined(EMSCRIPTEN)
+    if (pipeline == 0 || reported_pipelines.contains(pipeline))
+        return;
+
+    glValidateProgramPipeline(pipeline);
+    GLint status = GL_FALSE;
+    glGetProgramPipelineiv(pipeline, GL_VALIDATE_STATUS, &status);
+    if (status == GL_TRUE)
+        return;
+
+    reported_pipelines.insert(pipeline);
+    GLint length = 0;
+    glGetProgramPipelineiv(pipeline, GL_INFO_LOG_LENGTH, &length);
+    auto message = std::string(length, '\0');
+    glGetProgramPipelineInfoLog(pipeline, length, nullptr, message.data());
+    std::cerr << "Shader pipeline " << pipeline << " is not valid for this draw :\n" << message << std::endl;
+#endif
+}
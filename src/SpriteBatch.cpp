@@ -0,0 +1,200 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#include <sogl/SpriteBatch.hpp>
+#include <sogl/GlState.hpp>
+
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace sogl;
+
+namespace {
+    constexpr const auto* SPRITE_VERT_SRC = GLSL(330 core,
+        precision highp float;
+        uniform mat4 projection;
+
+        layout(location = 0) in vec2 i_pos;
+        layout(location = 1) in vec2 i_uv;
+        layout(location = 2) in vec4 i_col;
+
+        out vec2 uv;
+        out vec4 col;
+
+        void main() {
+            gl_Position = projection * vec4(i_pos.xy, 0., 1.);
+            uv = i_uv;
+            col = i_col;
+        }
+    );
+
+    constexpr const auto* SPRITE_FRAG_SRC = GLSL(330 core,
+        precision highp float;
+        uniform sampler2D texture0;
+
+        in vec2 uv;
+        in vec4 col;
+        out vec4 color;
+
+        void main() {
+            color = texture(texture0, uv) * col;
+        }
+    );
+
+    auto to_unorm8(float v) -> std::uint8_t {
+        return static_cast<std::uint8_t>(std::lround(std::clamp(v, 0.f, 1.f) * 255.f));
+    }
+}
+
+SpriteBatch::SpriteBatch() : m_vertex_array(Primitive::Triangles) {
+    // the sprites are rebuilt every frame
+    m_vertex_array.setStreaming();
+}
+
+void SpriteBatch::begin() {
+    m_sprites.clear();
+    m_stats = {};
+}
+
+void SpriteBatch::draw(const Sprite& sprite) {
+    m_sprites.push_back(sprite);
+}
+
+void SpriteBatch::end(const glm::mat4& projection) {
+    m_stats.sprites = m_sprites.size();
+    if (m_sprites.empty())
+        return;
+
+    // layer (16 bits), shader slot (16 bits) and texture slot (32 bits), ties keep the submission order
+    m_shader_slots.clear();
+    m_texture_slots.clear();
+    m_order.resize(m_sprites.size());
+    for (std::uint32_t i = 0; i < m_sprites.size(); ++i) {
+        auto& sprite = m_sprites[i];
+        if (sprite.shader == nullptr)
+            sprite.shader = &getDefaultShader();
+        if (sprite.texture == nullptr)
+            sprite.texture = &getWhiteTexture();
+
+        // clamped so that a layer out of the 16 bits range doesn't wrap around to the other end
+        const auto layer = static_cast<std::uint64_t>(std::clamp(sprite.layer, -0x8000, 0x7fff) + 0x8000);
+        const auto key = (layer << 48) | (slotOf(m_shader_slots, sprite.shader) << 32) | slotOf(m_texture_slots, sprite.texture);
+        m_order[i] = {key, i};
+    }
+    if (!std::is_sorted(m_order.begin(), m_order.end())) {
+        std::sort(m_order.begin(), m_order.end());
+    }
+
+    // write the quads straight into the vertex array storage
+    m_vertex_array.clear();
+    auto writer = m_vertex_array.emplace(m_sprites.size() * 4, m_sprites.size() * 6);
+    auto* vertices = writer.as<Vertex>();
+    auto* indices = writer.indices;
+
+    m_batches.clear();
+    for (std::size_t n = 0; n < m_order.size(); ++n) {
+        const auto& sprite = m_sprites[m_order[n].second];
+        const auto& t = sprite.transform;
+        const auto color = glm::u8vec4(to_unorm8(sprite.color.r), to_unorm8(sprite.color.g),
+                                       to_unorm8(sprite.color.b), to_unorm8(sprite.color.a));
+
+        const float xs[4] = {sprite.rect.x, sprite.rect.x + sprite.rect.z, sprite.rect.x + sprite.rect.z, sprite.rect.x};
+        const float ys[4] = {sprite.rect.y, sprite.rect.y, sprite.rect.y + sprite.rect.w, sprite.rect.y + sprite.rect.w};
+        const float us[4] = {sprite.uv.x, sprite.uv.z, sprite.uv.z, sprite.uv.x};
+        const float vs[4] = {sprite.uv.y, sprite.uv.y, sprite.uv.w, sprite.uv.w};
+        auto* quad = vertices + n * 4;
+        for (int k = 0; k < 4; ++k) {
+            quad[k].position = glm::vec2(t[0][0] * xs[k] + t[1][0] * ys[k] + t[2][0],
+                                         t[0][1] * xs[k] + t[1][1] * ys[k] + t[2][1]);
+            quad[k].uv = glm::vec2(us[k], vs[k]);
+            quad[k].color = color;
+        }
+
+        const auto first = static_cast<unsigned>(writer.base_vertex + n * 4);
+        auto* quad_indices = indices + n * 6;
+        quad_indices[0] = first;
+        quad_indices[1] = first + 1;
+        quad_indices[2] = first + 2;
+        quad_indices[3] = first;
+        quad_indices[4] = first + 2;
+        quad_indices[5] = first + 3;
+
+        // sprites of different layers sharing the same states stay in the same batch
+        if (m_batches.empty() || m_batches.back().shader != sprite.shader || m_batches.back().texture != sprite.texture) {
+            m_batches.push_back({sprite.shader, sprite.texture, n * 6, 0});
+        }
+        m_batches.back().index_count += 6;
+    }
+
+    // sprites are layered by draw order, not by depth
+    auto& state = GlState::current();
+    const auto depth_test = state.isEnabled(GL_DEPTH_TEST);
+    state.setEnabled(GL_DEPTH_TEST, false);
+
+    m_vertex_array.bind();
+    const Shader* bound_shader = nullptr;
+    const Texture* bound_texture = nullptr;
+    for (const auto& batch : m_batches) {
+        if (batch.shader != bound_shader) {
+            bound_shader = batch.shader;
+            bound_shader->bind();
+            bound_shader->setUniform("projection", projection);
+        }
+        if (batch.texture != bound_texture) {
+            bound_texture = batch.texture;
+            bound_texture->bind();
+        }
+        m_vertex_array.renderRange(batch.first_index, batch.index_count);
+    }
+    m_stats.draw_calls = m_batches.size();
+
+    state.setEnabled(GL_DEPTH_TEST, depth_test);
+}
+
+auto SpriteBatch::getStats() const -> const Stats& {
+    return m_stats;
+}
+
+auto SpriteBatch::getDefaultShader() -> const Shader& {
+    static auto loaded = false;
+    static Shader default_shader;
+
+    if (!loaded) {
+        auto vert_shader = Shader::compileVertex(SPRITE_VERT_SRC);
+        auto frag_shader = Shader::compileFragment(SPRITE_FRAG_SRC);
+        default_shader.load(vert_shader, frag_shader);
+        vert_shader.destroy();
+        frag_shader.destroy();
+        loaded = true;
+    }
+
+    return default_shader;
+}
+
+auto SpriteBatch::getWhiteTexture() -> const Texture& {
+    static auto created = false;
+    static Texture white_texture;
+
+    if (!created) {
+        const std::uint8_t white[4] = {255, 255, 255, 255};
+        white_texture.create(1, 1);
+        white_texture.copy(white, 0, 0, 1, 1);
+        created = true;
+    }
+
+    return white_texture;
+}
+
+auto SpriteBatch::slotOf(std::vector<const void*>& slots, const void* object) -> std::uint64_t {
+    // only a handful of distinct states per frame, the last one is usually the right one
+    if (!slots.empty() && slots.back() == object)
+        return slots.size() - 1;
+
+    const auto it = std::find(slots.begin(), slots.end(), object);
+    if (it != slots.end())
+        return static_cast<std::uint64_t>(it - slots.begin());
+
+    slots.push_back(object);
+    return slots.size() - 1;
+}
@@ -0,0 +1,26 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#include <sogl/StorageBuffer.hpp>
+
+#include <iostream>
+#include <unordered_map>
+
+using namespace sogl;
+
+#if !defined(EMSCRIPTEN)
+
+auto detail::storage_block_binding(const std::string& block_name) -> unsigned {
+    // binding points are handed out in the order the block names are first seen
+    static std::unordered_map<std::string, unsigned> bindings;
+    const auto [it, inserted] = bindings.try_emplace(block_name, static_cast<unsigned>(bindings.size()));
+    if (inserted) {
+        GLint max_bindings = 0;
+        glGetIntegerv(GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS, &max_bindings);
+        if (it->second >= static_cast<unsigned>(max_bindings)) {
+            std::cerr << "Storage block " << block_name << " exceeds the " << max_bindings
+                      << " shader storage buffer binding points" << std::endl;
+        }
+    }
+    return it->second;
+}
+#endif
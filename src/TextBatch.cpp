@@ -0,0 +1,115 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#include <sogl/TextBatch.hpp>
+#include <sogl/GlState.hpp>
+#include <sogl/SpriteBatch.hpp>
+
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace sogl;
+
+namespace {
+    auto to_unorm8(float v) -> std::uint8_t {
+        return static_cast<std::uint8_t>(std::lround(std::clamp(v, 0.f, 1.f) * 255.f));
+    }
+}
+
+TextBatch::TextBatch() : m_vertex_array(Primitive::Triangles) {
+    // the text is rebuilt every frame
+    m_vertex_array.setStreaming();
+}
+
+void TextBatch::begin() {
+    m_vertex_array.clear();
+    for (auto& page : m_pages) {
+        page.indices.clear();
+    }
+    m_stats = {};
+}
+
+void TextBatch::draw(Font& font, std::string_view text, int size, const glm::vec2& position, const glm::vec4& color) {
+    auto& page = pageOf(font, size);
+    const auto color8 = glm::u8vec4(to_unorm8(color.r), to_unorm8(color.g), to_unorm8(color.b), to_unorm8(color.a));
+    auto texel_size = glm::vec2(0.f);
+
+    font.shapeText(text, size, [&](const Glyph::Shape& shape) {
+        if (shape.w == 0.f || shape.h == 0.f)
+            return;
+
+        // the glyph page exists once the first glyph has been shaped
+        if (texel_size.x == 0.f) {
+            const auto texture_size = font.getTexture(size).getSize();
+            texel_size = glm::vec2(1.f / static_cast<float>(texture_size.x), 1.f / static_cast<float>(texture_size.y));
+        }
+
+        auto writer = m_vertex_array.emplace(4, 0);
+        auto* quad = writer.as<Vertex>();
+        const auto x0 = position.x + shape.x;
+        const auto y0 = position.y + shape.y;
+        const auto u0 = shape.u * texel_size.x;
+        const auto v0 = shape.v * texel_size.y;
+        const auto u1 = (shape.u + shape.w) * texel_size.x;
+        const auto v1 = (shape.v + shape.h) * texel_size.y;
+        quad[0] = {{x0, y0}, {u0, v0}, color8};
+        quad[1] = {{x0 + shape.w, y0}, {u1, v0}, color8};
+        quad[2] = {{x0 + shape.w, y0 + shape.h}, {u1, v1}, color8};
+        quad[3] = {{x0, y0 + shape.h}, {u0, v1}, color8};
+
+        const auto first = writer.base_vertex;
+        page.indices.insert(page.indices.end(), {first, first + 1, first + 2, first, first + 2, first + 3});
+        ++m_stats.glyphs;
+    });
+}
+
+void TextBatch::end(const glm::mat4& projection) {
+    // pages of fonts and sizes that were not used this frame are forgotten
+    std::erase_if(m_pages, [](const Page& page) { return page.indices.empty(); });
+    if (m_pages.empty())
+        return;
+
+    // the indices are grouped by page so that each page is a single draw
+    auto index_count = std::size_t(0);
+    for (const auto& page : m_pages) {
+        index_count += page.indices.size();
+    }
+    auto writer = m_vertex_array.emplace(0, index_count);
+    auto first_index = std::size_t(0);
+    for (auto& page : m_pages) {
+        std::memcpy(writer.indices + first_index, page.indices.data(), page.indices.size() * sizeof(unsigned));
+        page.first_index = first_index;
+        first_index += page.indices.size();
+    }
+
+    // text is layered by draw order, not by depth
+    auto& state = GlState::current();
+    const auto depth_test = state.isEnabled(GL_DEPTH_TEST);
+    state.setEnabled(GL_DEPTH_TEST, false);
+
+    const auto& shader = SpriteBatch::getDefaultShader();
+    shader.bind();
+    shader.setUniform("projection", projection);
+    m_vertex_array.bind();
+    for (const auto& page : m_pages) {
+        page.font->getTexture(page.size).bind();
+        m_vertex_array.renderRange(page.first_index, page.indices.size());
+    }
+    m_stats.draw_calls = m_pages.size();
+
+    state.setEnabled(GL_DEPTH_TEST, depth_test);
+}
+
+auto TextBatch::getStats() const -> const Stats& {
+    return m_stats;
+}
+
+auto TextBatch::pageOf(const Font& font, int size) -> Page& {
+    for (auto& page : m_pages) {
+        if (page.font == &font && page.size == size)
+            return page;
+    }
+    return m_pages.emplace_back(Page{&font, size, {}});
+}
@@ -1,6 +1,8 @@
 // Created by Modar Nasser on 05/03/2022.
 
 #include <sogl/Texture.hpp>
+#include <sogl/Buffer.hpp>
+#include <sogl/GlState.hpp>
 
 #include <GL/glew.h>
 
@@ -13,7 +15,7 @@ using namespace sogl;
 
 Texture::Texture() {
     glGenTextures(1, &m_texture);
-    glBindTexture(GL_TEXTURE_2D, m_texture);
+    bind();
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
@@ -21,7 +23,7 @@ Texture::Texture() {
 }
 
 Texture::~Texture() {
-    glDeleteTextures(1, &m_texture);
+    GlState::current().deleteTexture(m_texture);
 }
 
 void Texture::create(int width, int height) {
@@ -29,7 +31,7 @@ void Texture::create(int width, int height) {
     m_size.y = height;
 
     bind();
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_size.x, m_size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_size.x, m_size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
 }
 
 auto Texture::load(const std::filesystem::path& file) -> bool {
@@ -65,12 +67,36 @@ auto Texture::copy(const std::uint8_t* pixels, int x, int y, int width, int heig
     return true;
 }
 
-void Texture::bind() const {
-    glBindTexture(GL_TEXTURE_2D, m_texture);
+auto Texture::copy(const Buffer<std::uint8_t>& pixels, int x, int y, int width, int height) -> bool {
+    if (pixels.getSize() < static_cast<std::size_t>(width) * height * 4)
+        return false;
+
+    if (m_size.x == 0 && m_size.y == 0) {
+        create(x + width, y + height);
+    }
+
+    // with a pixel unpack buffer bound the pointer is an offset in the buffer
+    bind();
+    pixels.bind(BufferTarget::PixelUnpack);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    GlState::current().bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glGenerateMipmap(GL_TEXTURE_2D);
+
+    return true;
+}
+
+void Texture::bind(unsigned unit) const {
+    GlState::current().bindTexture(m_texture, unit);
+}
+
+#if !defined(EMSCRIPTEN)
+void Texture::bindImage(unsigned unit) const {
+    glBindImageTexture(unit, m_texture, 0, GL_FALSE, 0, GL_READ_WRITE, GL_RGBA8);
 }
+#endif
 
 void Texture::unbind() {
-    glBindTexture(GL_TEXTURE_2D, 0);
+    GlState::current().bindTexture(0);
 }
 
 auto Texture::getSize() const -> const glm::vec<2, int>& {
@@ -0,0 +1,23 @@
+// Created by Modar Nasser on 17/10/2026.
+
+#include <sogl/UniformBuffer.hpp>
+
+#include <iostream>
+#include <unordered_map>
+
+using namespace sogl;
+
+auto detail::uniform_block_binding(const std::string& block_name) -> unsigned {
+    // binding points are handed out in the order the block names are first seen
+    static std::unordered_map<std::string, unsigned> bindings;
+    const auto [it, inserted] = bindings.try_emplace(block_name, static_cast<unsigned>(bindings.size()));
+    if (inserted) {
+        GLint max_bindings = 0;
+        glGetIntegerv(GL_MAX_UNIFORM_BUFFER_BINDINGS, &max_bindings);
+        if (it->second >= static_cast<unsigned>(max_bindings)) {
+            std::cerr << "Uniform block " << block_name << " exceeds the " << max_bindings
+                      << " uniform buffer binding points" << std::endl;
+        }
+    }
+    return it->second;
+}
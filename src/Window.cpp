@@ -46,6 +46,7 @@ Window::Window(int width, int height, const std::string& title, Options options)
     m_size = {width, height};
     auto* glfw_window = glfwCreateWindow(width, height, title.c_str(), nullptr, nullptr);
     glfwMakeContextCurrent(glfw_window);
+    m_gl_state.makeCurrent();
     glfwSwapInterval(options.v_sync);
 #if !defined(EMSCRIPTEN)
     glfwSetInputMode(glfw_window, GLFW_LOCK_KEY_MODS, true);
@@ -81,7 +82,7 @@ Window::Window(int width, int height, const std::string& title, Options options)
     auto window_size_callback = [](GLFWwindow* window, int width, int height) {
         self->m_events.push(Event(Event::Resize{}, {width, height}));
         self->m_size = {width, height};
-        glViewport(0, 0, width, height);
+        self->m_gl_state.setViewport(0, 0, width, height);
     };
 
     auto window_drop_callback = [](GLFWwindow* window, int count, const char** paths) {
@@ -104,14 +105,14 @@ Window::Window(int width, int height, const std::string& title, Options options)
     }
     instance_count += 1;
 
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LESS);
+    m_gl_state.setEnabled(GL_DEPTH_TEST, true);
+    m_gl_state.setDepthFunc(GL_LESS);
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    m_gl_state.setEnabled(GL_BLEND, true);
+    m_gl_state.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 #if !defined(EMSCRIPTEN)
-    glEnable(GL_DEBUG_OUTPUT);
+    m_gl_state.setEnabled(GL_DEBUG_OUTPUT, true);
     glDebugMessageCallback(gl_debug_msg_cb, nullptr);
 #endif
 
@@ -165,13 +166,10 @@ auto Window::getHandle() -> void* {
 
 void Window::clear(const glm::vec<3, float>& color) {
     glfwMakeContextCurrent(getGlfwWindow(m_handle));
-    glViewport(0, 0, m_size.x, m_size.y);
+    m_gl_state.makeCurrent();
+    m_gl_state.setViewport(0, 0, m_size.x, m_size.y);
     glClearColor(color.r, color.g, color.b, 1.f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    glBindTexture(GL_TEXTURE_2D, 0);
-    glBindVertexArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
 auto Window::display() -> unsigned {